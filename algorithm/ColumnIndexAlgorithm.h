@@ -0,0 +1,307 @@
+/**
+ * This module represents the skeleton of the stop indexed algorithms (_313263204_c and _313263204_d), the way they plan
+ * a port's loads varies and is the algorithm's own loadContainers (a compile time call to Derived, no virtual calls).
+ * A container with stop s (the index in the route of the port it's unloaded at) placed on a column whose lowest stop
+ * is before s will have to be dug to reach the container under it (REHANDLE_COST), so the free columns are indexed
+ * by their stop:
+ *      - freeColumns holds (stop, column) of every column with a free floor that isn't dug at this port, so the in
+ *        order columns of a container are a range of it, found in logarithmic time.
+ *      - assignColumn finds the cheapest approved column for a container: the in order column with the closest stop
+ *        (the empty ones by balance, the ship's PlacementEngine), else the out of order column that is dug latest.
+ * The skeleton, at every port:
+ *      - unloads the containers of this port and the containers above them, a container above them is moved to
+ *        another column only if it's in stacking order there (MOVE_COST), otherwise it's unloaded and loaded back
+ *        (UNLOAD_AND_LOAD_COST, but no re-handle).
+ *      - loads the containers unloaded on the way and then the containers given in the input file (Derived).
+ *
+ *      *******      Derived      ******
+ * loadContainers   - void loadContainers(Type, InstructionWriter&) : loads the port's list, orderLoad sorts it and
+ *                    cuts it to the ship's free space, a loaded container is registered at the calculator and it's
+ *                    column reindexed.
+ *
+ * A new algorithm is a class deriving from ColumnIndexAlgorithm<itself>, registered by REGISTER_ALGORITHM.
+ */
+
+#ifndef SHIP1_COLUMN_INDEX_ALGORITHM_H
+#define SHIP1_COLUMN_INDEX_ALGORITHM_H
+
+#include <memory>
+#include <climits>
+#include "../interfaces/AbstractAlgorithm.h"
+#include "../common/Ship.h"
+#include "../common/Parser.h"
+#include "../common/Common.h"
+#include "../interfaces/AlgorithmRegistration.h"
+#include "../interfaces/WeightBalanceCalculator.h"
+#include "../common/Port.h"
+
+#define MOVE_COST 1
+#define UNLOAD_AND_LOAD_COST 2
+#define REHANDLE_COST 2
+
+template<typename Derived>
+class ColumnIndexAlgorithm: public AbstractAlgorithm {
+protected:
+    int portNum = 0;
+    std::unique_ptr<Ship> pShip;
+    std::shared_ptr<Port> pPort;
+    WeightBalanceCalculator calc;
+    std::array<bool,NUM_OF_ERRORS> errorCodes{false};
+    std::set<std::string> idSet;
+    /*(stop, x * Y + y) of every column with a free floor that isn't dug at this port, ordered for best fit*/
+    std::set<std::pair<int,int>> freeColumns;
+    std::vector<int> indexedStops; /*the stop each column is indexed by at freeColumns, NO_COLUMN if it isn't*/
+public:
+    explicit ColumnIndexAlgorithm(): AbstractAlgorithm(){}
+    ~ColumnIndexAlgorithm() override= default;
+
+    /*-------------- Overriding Methods --------------*/
+    int readShipPlan(const std::string& full_path_and_file_name) override;
+    int readShipRoute(const std::string& full_path_and_file_name) override;
+    int setWeightBalanceCalculator(WeightBalanceCalculator& calculator) override;
+    int getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) override;
+
+    /*-------------- Supporting Methods --------------*/
+    void indexColumns();
+    void reindexColumn(int x, int y);
+    bool assignColumn(int kg, int stop, coordinate& coor, int& cost);
+    bool assignColumn(int kg, int stop, coordinate& coor);
+    void unloadContainers(InstructionWriter &output);
+    bool handleBlocker(coordinate coor, InstructionWriter &output);
+    bool unloadSingleContainer(InstructionWriter &output, coordinate coor, Type vecType);
+    std::vector<Container>* orderLoad(Type list_category, InstructionWriter &output);
+    int resetAndReturn();
+};
+
+/**
+ * indexes every column with a free floor that isn't excluded at the ship's placement engine by it's stop
+ */
+template<typename Derived>
+void ColumnIndexAlgorithm<Derived>::indexColumns(){
+    int X = pShip->getAxis("x"), Y = pShip->getAxis("y");
+    freeColumns.clear();
+    indexedStops.assign(X * Y, NO_COLUMN);
+    for(int x = 0; x < X; x++)
+        for(int y = 0; y < Y; y++)
+            reindexColumn(x, y);
+}
+
+/**
+ * updates the index of the column after it changed
+ */
+template<typename Derived>
+void ColumnIndexAlgorithm<Derived>::reindexColumn(int x, int y){
+    int column = x * pShip->getAxis("y") + y;
+    if(indexedStops[column] != NO_COLUMN)
+        freeColumns.erase({indexedStops[column], column});
+    indexedStops[column] = pShip->getPlacementEngine().getStop(x, y);
+    if(indexedStops[column] != NO_COLUMN)
+        freeColumns.insert({indexedStops[column], column});
+}
+
+/**
+ * finds the cheapest column approved by the calculator to place a container of kg with stop on, nothing is registered.
+ * the in order columns are tried by their stop, closest first (the empty ones by balance), then the out of order
+ * columns, the latest dug first.
+ * @param cost - set to the expected re-handle cost of placing the container on the column found
+ * @return true iff a column was found
+ */
+template<typename Derived>
+bool ColumnIndexAlgorithm<Derived>::assignColumn(int kg, int stop, coordinate& coor, int& cost){
+    int Y = pShip->getAxis("y");
+    BalanceMask approved = calc.approvedColumns('L', kg);
+    auto inOrder = freeColumns.lower_bound({stop, INT_MIN});
+    if(inOrder != freeColumns.end() && inOrder->first == NEVER_LEAVES){
+        int X = 0, balancedY = 0;
+        if(pShip->getPlacementEngine().findColumn(kg, NEVER_LEAVES, X, balancedY) && approved.test(X, balancedY)){
+            coor = std::make_tuple(X, balancedY);
+            cost = 0;
+            return true;
+        }
+    }
+    for(auto it = inOrder; it != freeColumns.end(); ++it){
+        if(approved.test(it->second / Y, it->second % Y)){
+            coor = std::make_tuple(it->second / Y, it->second % Y);
+            cost = 0;
+            return true;
+        }
+    }
+    for(auto it = inOrder; it != freeColumns.begin();){
+        --it;
+        if(approved.test(it->second / Y, it->second % Y)){
+            coor = std::make_tuple(it->second / Y, it->second % Y);
+            cost = REHANDLE_COST;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * as assignColumn, for a caller that doesn't weigh the column's cost (it's the cheapest column anyway)
+ */
+template<typename Derived>
+bool ColumnIndexAlgorithm<Derived>::assignColumn(int kg, int stop, coordinate& coor){
+    int cost = 0;
+    return assignColumn(kg, stop, coor, cost);
+}
+
+/**
+ * This function unloads all the containers of this port and the containers above them:
+ *      - find the lowest container of this port at every column (a single pass over the ship)
+ *      - exclude those columns from the placement, they are being dug
+ *      - unload the column's containers down to that floor, containers of other ports are moved or
+ *        unloaded by their cost (see handleBlocker)
+ * @param output - output file to write instructions for crane
+ */
+template<typename Derived>
+void ColumnIndexAlgorithm<Derived>::unloadContainers(InstructionWriter& output){
+    PlacementEngine& engine = pShip->getPlacementEngine();
+    std::vector<std::tuple<int,int,int>> dug;
+    for(int x = 0; x < pShip->getAxis("x"); x++){
+        for(int y = 0; y < pShip->getAxis("y"); y++){
+            int lowest_floor = pShip->getLowestFloorOfRelevantContainer(pPort, coordinate(x, y));
+            if(lowest_floor < pShip->getTopFloor(coordinate(x, y))){
+                dug.emplace_back(x, y, lowest_floor);
+                engine.setExcluded(x, y, true);
+            }
+        }
+    }
+    indexColumns();
+    for(auto& [x, y, lowest_floor] : dug){
+        coordinate coor(x, y);
+        std::vector<Container>* column = nullptr;
+        pShip->getColumn(coor, &column);
+        while((int)column->size() > lowest_floor){
+            bool handled = *(column->back().getDest()) == *pPort ? unloadSingleContainer(output, coor, Type::ARRIVED) :
+                                                                  handleBlocker(coor, output);
+            if(!handled)
+                break;
+        }
+        engine.setExcluded(x, y, false);
+        reindexColumn(x, y);
+    }
+}
+
+/**
+ * handles the top container of a dug column, that isn't unloaded at this port:
+ * moving it costs MOVE_COST plus the expected re-handle of the column it's moved to, unloading and loading it back
+ * costs UNLOAD_AND_LOAD_COST (it's loaded back in order by loadContainers), the cheaper one is taken.
+ * @return false iff the container was rejected (the unload wasn't approved)
+ */
+template<typename Derived>
+bool ColumnIndexAlgorithm<Derived>::handleBlocker(coordinate coor, InstructionWriter& output){
+    int X = std::get<0>(coor), Y = std::get<1>(coor);
+    std::vector<Container>* column = nullptr;
+    pShip->getColumn(coor, &column);
+    Container con = column->back();
+    int stop = std::get<1>(pShip->getPlacementEngine().top(X, Y));
+    int floor = (int)column->size() - 1;
+    coordinate new_spot;
+    int rehandleCost = 0;
+    size_t checkpoint = calc.checkpoint();
+    if(calc.tryOperation('U', con.getWeight(), X, Y) == APPROVED &&
+       assignColumn(con.getWeight(), stop, new_spot, rehandleCost) && MOVE_COST + rehandleCost < UNLOAD_AND_LOAD_COST &&
+       calc.tryOperation('L', con.getWeight(), std::get<0>(new_spot), std::get<1>(new_spot)) == APPROVED){
+        calc.commit(checkpoint);
+        pShip->moveContainer(coor, new_spot);
+        reindexColumn(std::get<0>(new_spot), std::get<1>(new_spot));
+        std::tuple<int,int,int> new_coor(std::get<0>(new_spot), std::get<1>(new_spot), pShip->getTopFloor(new_spot) - 1);
+        writeToOutput(output, Action::MOVE, con.getId(), std::tuple<int,int,int>(X, Y, floor), new_coor);
+        return true;
+    }
+    calc.rollback(checkpoint);
+    return unloadSingleContainer(output, coor, Type::PRIORITY);
+}
+
+/**
+ * executes 'unload' action of the top container at coor by removing it from ship and adding it to port,
+ * if the calculator declines the unload it's rejected instead.
+ * @return true iff the container was unloaded
+ */
+template<typename Derived>
+bool ColumnIndexAlgorithm<Derived>::unloadSingleContainer(InstructionWriter &output, coordinate coor, Type vecType){
+    std::vector<Container>* column = nullptr;
+    pShip->getColumn(coor, &column);
+    Container con = column->back();
+    std::tuple<int,int,int> position(std::get<0>(coor), std::get<1>(coor), (int)column->size() - 1);
+    if(calc.tryOperation('U', con.getWeight(), std::get<0>(coor), std::get<1>(coor)) != APPROVED){
+        writeToOutput(output, Action::REJECT, con.getId(), position);
+        return false;
+    }
+    pPort->addContainer(con, vecType);
+    writeToOutput(output, Action::UNLOAD, con.getId(), position);
+    pShip->removeContainer(coor);
+    return true;
+}
+
+/**
+ * sorts the port's list by the distance of the containers from their destination and rejects the containers beyond
+ * the ship's free space from it's end, the rest are loaded in reverse order (farthest first).
+ * @return the list, nullptr if the port has none
+ */
+template<typename Derived>
+std::vector<Container>* ColumnIndexAlgorithm<Derived>::orderLoad(Type list_category, InstructionWriter& output){
+    std::vector<Container>* load = pPort->getContainerVec(list_category);
+    if(load == nullptr) return nullptr;
+    for(auto& con : *load)
+        con.setDistance(pShip->getStop(con.getDest(), portNum) - portNum);
+    std::sort(load->begin(), load->end());
+    while(pShip->getFreeSpace() < (int)load->size()){
+        writeToOutput(output, AbstractAlgorithm::Action::REJECT, load->back().getId());
+        load->pop_back();
+    }
+    return load;
+}
+
+template<typename Derived>
+int ColumnIndexAlgorithm<Derived>::readShipPlan(const std::string& full_path_and_file_name){
+    return extractShipPlan(full_path_and_file_name, this->pShip) ||
+        extractArgsForBlocks(this->pShip, full_path_and_file_name);
+}
+
+template<typename Derived>
+int ColumnIndexAlgorithm<Derived>::readShipRoute(const std::string& full_path_and_file_name) {
+    return extractTravelRoute(pShip, full_path_and_file_name);
+}
+
+template<typename Derived>
+int ColumnIndexAlgorithm<Derived>::setWeightBalanceCalculator(WeightBalanceCalculator& calculator) {
+    calc = calculator;
+    return 0;
+}
+
+template<typename Derived>
+int ColumnIndexAlgorithm<Derived>::getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) {
+    if(portNum > static_cast<int>(pShip->getRoute().size())) portNum = 0;
+    this->pPort = pShip->getRoute().at(portNum);
+    InstructionWriter output(output_full_path_and_file_name);
+    bool lastPort = portNum == static_cast<int>(pShip->getRoute().size());
+
+    parseDataToPort(input_full_path_and_file_name, output, pShip, pPort, idSet, errorCodes, lastPort);
+
+    unloadContainers(output);
+    static_cast<Derived*>(this)->loadContainers(Type::PRIORITY,output);
+    static_cast<Derived*>(this)->loadContainers(Type::LOAD,output);
+
+    output.close();
+    return resetAndReturn();
+}
+
+/**
+ * resets errors code supporting members and prepares algorithm for next port
+ * @return errors code
+ */
+template<typename Derived>
+int ColumnIndexAlgorithm<Derived>::resetAndReturn() {
+    int code = 0;
+    for(int i = 0; i < NUM_OF_ERRORS; ++i){
+        if(errorCodes.at(i)) code += 1 << i;
+    }
+    this->errorCodes = std::array<bool,NUM_OF_ERRORS>{false};
+    idSet.clear();
+    ++portNum;
+    return code;
+}
+
+#endif
@@ -0,0 +1,337 @@
+/**
+ * This module represents the skeleton of a lifo stowage algorithm, the steps that vary between algorithms are
+ * compile time policies (static functions of the policy types), so every instantiation is compiled to it's own
+ * inlined code with no virtual calls.
+ * The skeleton, at every port:
+ *      - unloads the containers of this port and the containers above them (UnloadOrder chooses the columns),
+ *        a container above them is moved to another column if Placement finds one, otherwise it's unloaded and
+ *        loaded back.
+ *      - loads the containers unloaded on the way and then the containers given in the input file, every list is
+ *        ordered by LoadOrder, RejectSelection chooses how many to reject from it's end and the rest are loaded
+ *        from the end of the list to the column Placement finds.
+ *
+ *      *******      Policies      ******
+ * UnloadOrder      - static void columns(Ship&, std::shared_ptr<Port>&, std::vector<Container>& containersToUnload,
+ *                                        std::set<coordinate>& columns) : the columns to unload.
+ * LoadOrder        - static void order(Ship&, int portNum, std::vector<Container>& load) : orders the containers
+ *                    to load (the last ones are loaded first).
+ * RejectSelection  - static size_t rejects(Ship&, const std::vector<Container>& load) : the number of containers
+ *                    to reject from the end of the ordered list before loading.
+ * Placement        - static bool load(Ship&, coordinate&, int kg, int stop, WeightBalanceCalculator&) : the column to
+ *                    load to (stop is the index in the route of the container's destination, see Ship::getStop),
+ *                    nothing is registered at the calculator (the skeleton registers the loads it makes).
+ *                    static bool move(Ship&, coordinate from, coordinate& to, std::vector<Container>& containersToUnload,
+ *                                     int kg, WeightBalanceCalculator&) : the column to move a container to.
+ *
+ * A new algorithm is a class deriving from an instantiation, registered by REGISTER_ALGORITHM.
+ */
+
+#ifndef SHIP1_STOWAGE_ALGORITHM_H
+#define SHIP1_STOWAGE_ALGORITHM_H
+
+#include <memory>
+#include <unordered_set>
+#include <unordered_map>
+#include "../interfaces/AbstractAlgorithm.h"
+#include "../common/Ship.h"
+#include "../common/Parser.h"
+#include "../common/Common.h"
+#include "../interfaces/AlgorithmRegistration.h"
+#include "../interfaces/WeightBalanceCalculator.h"
+#include "../common/Port.h"
+
+/*-------------- Unload Ordering --------------*/
+
+/**
+ * the columns holding containers of the port, by coordinate
+ */
+struct ByCoordinateUnloadOrder {
+    static void columns(Ship& ship, std::shared_ptr<Port>&, std::vector<Container>& containersToUnload,
+                        std::set<coordinate>& columns){
+        ship.getCoordinatesToHandle(columns, containersToUnload);
+    }
+};
+
+/*-------------- Load Ordering --------------*/
+
+/**
+ * the containers as given
+ */
+struct InputLoadOrder {
+    static void order(Ship&, int, std::vector<Container>&){}
+};
+
+/**
+ * sorted by the distance of their destination (it's next visit from this port on, by name), the farthest ones are
+ * loaded first (lower on the ship)
+ */
+struct ByDistanceLoadOrder {
+    static void order(Ship& ship, int portNum, std::vector<Container>& load){
+        auto route = ship.getRoute();
+        std::unordered_map<std::string,int> distances;
+        for(int stop = (int)route.size() - 1; stop >= portNum; stop--)
+            distances[route[stop]->get_name()] = stop - portNum + 1;
+        for(auto& con : load){
+            auto distance = distances.find(con.getDest()->get_name());
+            if(distance != distances.end())
+                con.setDistance(distance->second);
+        }
+        std::sort(load.begin(), load.end());
+    }
+};
+
+/*-------------- Reject Selection --------------*/
+
+/**
+ * nothing is rejected in advance, a container that doesn't fit is rejected when it's placement fails
+ */
+struct NoRejects {
+    static size_t rejects(Ship&, const std::vector<Container>&){ return 0; }
+};
+
+/**
+ * the containers beyond the ship's free space
+ */
+struct OverCapacityRejects {
+    static size_t rejects(Ship& ship, const std::vector<Container>& load){
+        return ship.getFreeSpace() < (int)load.size() ? load.size() - std::max(ship.getFreeSpace(), 0) : 0;
+    }
+};
+
+/*-------------- Placement Search --------------*/
+
+/**
+ * the ship's first fit column search, a load is only searched (approvedColumns) and a move is registered
+ */
+struct FirstFitPlacement {
+    static bool load(Ship& ship, coordinate& coor, int kg, int, WeightBalanceCalculator& calc){
+        bool found = false;
+        ship.findColumnToLoad(coor, found, kg, calc);
+        return found;
+    }
+    static bool move(Ship& ship, coordinate from, coordinate& to, std::vector<Container>& containersToUnload,
+                     int kg, WeightBalanceCalculator& calc){
+        return ship.findColumnToMoveTo(from, to, containersToUnload, kg, calc);
+    }
+};
+
+/**
+ * the ship's placement engine, the column that keeps the ship balanced among the ones the container is stacked in
+ * order on, a load is only searched and a move is registered (as FirstFitPlacement)
+ */
+struct BalancedPlacement {
+    static bool load(Ship& ship, coordinate& coor, int kg, int stop, WeightBalanceCalculator& calc){
+        return ship.findBalancedColumnToLoad(coor, kg, stop, calc);
+    }
+    static bool move(Ship& ship, coordinate from, coordinate& to, std::vector<Container>& containersToUnload,
+                     int, WeightBalanceCalculator& calc){
+        return ship.findBalancedColumnToMoveTo(from, to, containersToUnload, calc);
+    }
+};
+
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+class StowageAlgorithm: public AbstractAlgorithm {
+protected:
+    int portNum = 0;
+    std::unique_ptr<Ship> pShip;
+    std::shared_ptr<Port> pPort;
+    WeightBalanceCalculator calc;
+    std::array<bool,NUM_OF_ERRORS> errorCodes{false};
+    std::set<std::string> idSet;
+public:
+    explicit StowageAlgorithm(): AbstractAlgorithm(){}
+    ~StowageAlgorithm() override= default;
+
+    /*-------------- Overriding Methods --------------*/
+    int readShipPlan(const std::string& full_path_and_file_name) override;
+    int readShipRoute(const std::string& full_path_and_file_name) override;
+    int setWeightBalanceCalculator(WeightBalanceCalculator& calculator) override;
+    int getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) override;
+
+    /*-------------- Supporting Methods --------------*/
+    void unloadContainers(InstructionWriter &output);
+    void handleColumn(coordinate coor, vector<Container> *column, int lowest_floor, vector<Container> *containersToUnload, InstructionWriter &output);
+    void unloadSingleContainer(InstructionWriter &output, Container &con, Type vecType, coordinate coor);
+    void loadContainers(Type list_category, InstructionWriter &output);
+    int getPortNum();
+    int resetAndReturn();
+};
+
+/**
+ * This function unloads all the containers that need to be unloaded to port by these scheme:
+ *      - get all containers to unload
+ *      - find the columns of those containers inside the ship (UnloadOrder)
+ *      - unload containers that are in those columns to port
+ *      - stop unload when hits the port's container
+ * @param output - output file to write instructions for crane
+ */
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+void StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::unloadContainers(InstructionWriter& output){
+    std::vector<Container>* containersToUnload = nullptr;
+    pShip->getContainersToUnload(pPort, &containersToUnload);
+    std::set<coordinate> coordinates_to_handle;
+    UnloadOrder::columns(*pShip, pPort, *containersToUnload, coordinates_to_handle);
+
+    for(coordinate coor : coordinates_to_handle){
+        int lowest_floor = pShip->getLowestFloorOfRelevantContainer(pPort, coor);
+        std::vector<Container>* column = nullptr;
+        pShip->getColumn(coor, &column);
+        handleColumn(coor, column, lowest_floor, containersToUnload, output);
+    }
+}
+
+/**
+ * gets a coordinate in ship's map and unloads the containers in that column.
+ * the unloading happens only untill the lowest_floor index which represents the lowest index of a container
+ * related to current port.
+ * related containers to current port arrived to their destination and wont be loaded back to ship
+ * unrelated containers to current port are moved to the column Placement finds, or else asured to be loaded back to ship.
+ */
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+void StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::handleColumn(coordinate coor, std::vector<Container>* column, int lowest_floor,
+                                std::vector<Container>* containersToUnload, InstructionWriter& output){
+    int X = std::get<0>(coor); int Y =  std::get<1>(coor);
+    for(auto con_iterator = column->end() - 1; !column->empty() && con_iterator >= column->begin();){
+        if(con_iterator - column->begin() == lowest_floor - 1) break;
+        if(*(con_iterator->getDest()) == *pPort){
+            if(calc.tryOperation('U', con_iterator->getWeight(), X, Y) == APPROVED){
+                unloadSingleContainer(output, *con_iterator, Type::ARRIVED, coor);
+                --con_iterator;
+            }
+            else{
+                writeToOutput(output, Action::REJECT, con_iterator->getId(), pShip->getCoordinate(*con_iterator));
+                break;
+            }
+        }
+        else {
+            coordinate new_spot;
+            bool found = Placement::move(*pShip, coor, new_spot, *containersToUnload, con_iterator->getWeight(), calc);
+            if(!found){
+                if(calc.tryOperation('U', con_iterator->getWeight(), X, Y) == APPROVED){
+                    unloadSingleContainer(output, *con_iterator, Type::PRIORITY, coor);
+                    --con_iterator;
+                }
+                else {
+                    writeToOutput(output, Action::REJECT, con_iterator->getId(), pShip->getCoordinate(*con_iterator));
+                    break;
+                }
+            }
+            else {
+                std::tuple<int,int,int> old_coor = pShip->getCoordinate(*con_iterator);
+                std::string id = con_iterator->getId();
+                pShip->moveContainer(coor, new_spot);
+                std::tuple<int,int,int> new_coor(std::get<0>(new_spot),std::get<1>(new_spot),pShip->getTopFloor(new_spot) - 1);
+                writeToOutput(output,Action::MOVE, id, old_coor, new_coor);
+                --con_iterator;
+            }
+        }
+    }
+}
+
+/**
+ * loads port's containers to ship by this scheme:
+ *      -order containers (LoadOrder).
+ *      -reject the containers RejectSelection chooses from the end of the list.
+ *      -load containers in reverse order to the column Placement finds.
+ * the route's ports are indexed once for the whole list, and the list is cleared once at the end.
+ * @param output - output file to write instructions for crane
+ */
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+void StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::loadContainers(Type list_category, InstructionWriter& output){
+    std::vector<Container>* load = pPort->getContainerVec(list_category);
+    if(load == nullptr) return;
+    LoadOrder::order(*pShip, portNum, *load);
+    for(size_t rejects = RejectSelection::rejects(*pShip, *load); rejects > 0 && !load->empty(); --rejects){
+        writeToOutput(output, AbstractAlgorithm::Action::REJECT, load->back().getId());
+        load->pop_back();
+    }
+    std::unordered_set<std::string> portsInRoute = getPortsInRoute(pShip->getRoute(), getPortNum());
+    for(auto con = load->rbegin(); con != load->rend(); ++con){
+        coordinate coor;
+        int weight = con->getWeight();
+        int stop = pShip->getStop(con->getDest(), portNum);
+        /*valid id, destination in route and unique id on ship are checked before the column is searched*/
+        bool loadable = isValidId(con->getId()) && portsInRoute.count(con->getDest()->get_name()) > 0 &&
+                        !pShip->isOnShip(*con);
+        /*the search registers nothing, the load is registered only for the container that is loaded*/
+        bool found = loadable && Placement::load(*pShip, coor, weight, stop, calc) &&
+                     calc.tryOperation('L', weight, std::get<0>(coor), std::get<1>(coor)) == APPROVED;
+
+        if(found){
+            pShip->addContainer(*con, coor, stop);
+            writeToOutput(output, Action::LOAD, con->getId(),
+                          std::tuple<int,int,int>(std::get<0>(coor), std::get<1>(coor), pShip->getTopFloor(coor) - 1));
+        } else {
+            writeToOutput(output, Action::REJECT, con->getId());
+        }
+    }
+    load->clear();
+}
+
+/**
+ * executes 'unload' action by removing con from ship
+ * and adding it tp port.
+ */
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+void StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::unloadSingleContainer(InstructionWriter &output, Container& con, Type vecType, coordinate coor){
+    pPort->addContainer(con, vecType);
+    writeToOutput(output, Action::UNLOAD, con.getId(), pShip->getCoordinate(con));
+    pShip->removeContainer(coor);
+}
+
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+int StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::getPortNum() {
+    return portNum;
+}
+
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+int StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::readShipPlan(const std::string& full_path_and_file_name){
+    return extractShipPlan(full_path_and_file_name, this->pShip) ||
+        extractArgsForBlocks(this->pShip, full_path_and_file_name);
+}
+
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+int StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::readShipRoute(const std::string& full_path_and_file_name) {
+    return extractTravelRoute(pShip, full_path_and_file_name);
+}
+
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+int StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::setWeightBalanceCalculator(WeightBalanceCalculator& calculator) {
+    calc = calculator;
+    return 0;
+}
+
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+int StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) {
+    if(portNum > static_cast<int>(pShip->getRoute().size())) portNum = 0;
+    this->pPort = pShip->getRoute().at(portNum);
+    InstructionWriter output(output_full_path_and_file_name);
+    bool lastPort = portNum == static_cast<int>(pShip->getRoute().size());
+
+    parseDataToPort(input_full_path_and_file_name, output, pShip, pPort, idSet, errorCodes, lastPort);
+
+    unloadContainers(output);
+    loadContainers(Type::PRIORITY,output);
+    loadContainers(Type::LOAD,output);
+
+    output.close();
+    return resetAndReturn();
+}
+
+/**
+ * resets errors code supporting members and prepares algorithm for next port
+ * @return errors code
+ */
+template<typename UnloadOrder, typename LoadOrder, typename RejectSelection, typename Placement>
+int StowageAlgorithm<UnloadOrder, LoadOrder, RejectSelection, Placement>::resetAndReturn() {
+    int code = 0;
+    for(int i = 0; i < NUM_OF_ERRORS; ++i){
+        if(errorCodes.at(i)) code += 1 << i;
+    }
+    this->errorCodes = std::array<bool,NUM_OF_ERRORS>{false};
+    idSet.clear();
+    ++portNum;
+    return code;
+}
+
+#endif
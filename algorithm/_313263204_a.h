@@ -6,46 +6,21 @@
  * (Containers that not getting in the way between containers.destination == this.port to the port are not unloaded! no unnecessary action).
  * Second, it loads containers with destination != this port.
  * Finally, it loads containers given in input file.
+ * The containers to load are sorted by distance and the ones beyond the ship's free space are rejected in advance.
+ * Every container is loaded (or moved) to the column the ship's placement engine finds (BalancedPlacement): among the
+ * columns it's stacked in order on, the one that keeps the ship balanced.
  */
 
 #ifndef SHIP1_LIFO_ALGORITHM_H
 #define SHIP1_LIFO_ALGORITHM_H
 
-#include <memory>
-#include "../interfaces/AbstractAlgorithm.h"
-#include "../common/Ship.h"
-#include "../common/Parser.h"
-#include "../common/Common.h"
-#include "../interfaces/AlgorithmRegistration.h"
-#include "../interfaces/WeightBalanceCalculator.h"
-#include "../common/Port.h"
+#include "StowageAlgorithm.h"
 
-class _313263204_a: public AbstractAlgorithm {
+class _313263204_a: public StowageAlgorithm<ByCoordinateUnloadOrder, ByDistanceLoadOrder, OverCapacityRejects, BalancedPlacement> {
     const std::string name = "_313263204_a";
-    int portNum = 0;
-    std::unique_ptr<Ship> pShip;
-    std::shared_ptr<Port> pPort;
-    WeightBalanceCalculator calc;
-    std::array<bool,NUM_OF_ERRORS> errorCodes{false};
-    std::set<std::string> idSet;
 public:
-    explicit _313263204_a(): AbstractAlgorithm(){}
+    explicit _313263204_a(): StowageAlgorithm(){}
     ~_313263204_a() override= default;
-
-    /*-------------- Overriding Methods --------------*/
-    int readShipPlan(const std::string& full_path_and_file_name) override;
-    int readShipRoute(const std::string& full_path_and_file_name) override;
-    int setWeightBalanceCalculator(WeightBalanceCalculator& calculator) override;
-    int getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) override;
-
-    /*-------------- Supporting Methods --------------*/
-    void unloadContainers(std::ofstream &output);
-    void handleColumn(coordinate coor, vector<Container> *column, int lowest_floor, vector<Container> *containersToUnload, std::ofstream &output);
-    void unloadSingleContainer(std::ofstream &output, Container &con, Type vecType, coordinate coor);
-    void loadContainers(Type list_category, std::ofstream &output);
-    void initContainersDistance(vector<Container> &vector);
-    int getPortNum();
-    int resetAndReturn();
 };
 
-#endif
\ No newline at end of file
+#endif
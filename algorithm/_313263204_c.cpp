@@ -0,0 +1,33 @@
+#include "_313263204_c.h"
+
+REGISTER_ALGORITHM (_313263204_c)
+
+/**
+ * loads port's containers to ship by this scheme:
+ *      -sort containers by distance from destination and cut them to the free space in ship (orderLoad).
+ *      -load containers in reverse order (farthest first), each to the column assignColumn finds.
+ * @param output - output file to write instructions for crane
+ */
+void _313263204_c::loadContainers(Type list_category, InstructionWriter& output){
+    std::vector<Container>* load = orderLoad(list_category, output);
+    if(load == nullptr) return;
+    auto route = pShip->getRoute();
+    for(auto con = load->end() - 1; !load->empty() && con >= load->begin();--con){
+        int stop = pShip->getStop(con->getDest(), portNum);
+        bool loaded = false;
+        if(isValidId(con->getId()) && isPortInRoute(con->getDest()->get_name(), route, portNum) && !pShip->isOnShip(*con)){
+            coordinate coor;
+            if(assignColumn(con->getWeight(), stop, coor) &&
+               calc.tryOperation('L', con->getWeight(), std::get<0>(coor), std::get<1>(coor)) == APPROVED){
+                pShip->addContainer(*con, coor, stop);
+                reindexColumn(std::get<0>(coor), std::get<1>(coor));
+                writeToOutput(output, Action::LOAD, con->getId(),
+                              std::tuple<int,int,int>(std::get<0>(coor), std::get<1>(coor), pShip->getTopFloor(coor) - 1));
+                loaded = true;
+            }
+        }
+        if(!loaded)
+            writeToOutput(output, Action::REJECT, con->getId());
+        load->erase(con);
+    }
+}
@@ -0,0 +1,31 @@
+/**
+ * This module represents a per port optimizing algorithm.
+ * Every port visit is solved as an assignment of containers to columns, the cost of placing a container with stop s
+ * (the index in the route of the port it's unloaded at) on a column is the crane operations it takes now plus the
+ * expected re-handles at later ports: a column whose lowest stop is before s will have to be dug to reach the
+ * container under it (REHANDLE_COST), so placing there costs more than placing in stacking order.
+ * The assignment is solved by a greedy best fit heuristic, O(log) per container:
+ *      - the containers are placed farthest stop first, so a column in order for a container stays in order for the next.
+ *      - a container is placed on the column assignColumn finds (ColumnIndexAlgorithm): the in order column with the
+ *        closest stop (keeping the columns that leave late for later ports), the empty columns are chosen by balance.
+ *      - if no column is in order, the column that is dug latest is taken.
+ * The unloads are the ones of ColumnIndexAlgorithm, a container above the port's containers is moved to another
+ * column only if it's in stacking order there (1 operation), otherwise it's unloaded and loaded back (2 operations,
+ * but no re-handle).
+ */
+
+#ifndef SHIP1_OPTIMIZER_ALGORITHM_H
+#define SHIP1_OPTIMIZER_ALGORITHM_H
+
+#include "ColumnIndexAlgorithm.h"
+
+class _313263204_c: public ColumnIndexAlgorithm<_313263204_c> {
+    const std::string name = "_313263204_c";
+public:
+    explicit _313263204_c(): ColumnIndexAlgorithm(){}
+    ~_313263204_c() override= default;
+
+    void loadContainers(Type list_category, InstructionWriter &output);
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include "_313263204_d.h"
+
+REGISTER_ALGORITHM (_313263204_d)
+
+/**
+ * the port budget is taken from the PORT_EXPANSIONS_ENV environment variable and the port deadline from
+ * PORT_DEADLINE_ENV if they're set to a non negative integer, the number of search threads from SEARCH_THREADS_ENV
+ * if it's set to a positive integer, else it's the number of cores (at most BEAM_CANDIDATES, the plans of a decision).
+ */
+_313263204_d::_313263204_d(): ColumnIndexAlgorithm(){
+    const char* budget = std::getenv(PORT_EXPANSIONS_ENV);
+    if(budget != nullptr && isValidInteger(budget) && std::atoll(budget) >= 0)
+        portBudget = std::atoll(budget);
+    const char* deadline = std::getenv(PORT_DEADLINE_ENV);
+    if(deadline != nullptr && isValidInteger(deadline) && std::atoi(deadline) >= 0)
+        portTimeCap = std::chrono::milliseconds(std::atoi(deadline));
+    int numThreads = std::clamp((int)std::thread::hardware_concurrency(), 1, BEAM_CANDIDATES);
+    const char* threads = std::getenv(SEARCH_THREADS_ENV);
+    if(threads != nullptr && isValidInteger(threads) && std::atoi(threads) > 0)
+        numThreads = std::atoi(threads);
+    search = std::make_unique<ParallelSearch>(numThreads);
+}
+
+/**
+ * @return the state of the column after the decisions of state, the column is either changed by them or free
+ */
+_313263204_d::ColumnState _313263204_d::columnState(const BeamState& state, int column) const {
+    for(auto& changed : state.changed)
+        if(changed.column == column)
+            return changed;
+    int Y = pShip->getAxis("y");
+    return ColumnState{column, pShip->getPlacementEngine().getHeight(column / Y, column % Y), indexedStops[column]};
+}
+
+/**
+ * adds to children the states of placing item on every candidate column of state:
+ * the two in order columns with the closest stops, the most balanced empty column and the out of order column
+ * with the latest stop, among the free columns and the columns changed by state, approved by the calculator.
+ */
+void _313263204_d::expandState(const BeamState& state, const Item& item, const BalanceMask& approved,
+                               std::vector<BeamState>& children) const {
+    int Y = pShip->getAxis("y"), Z = pShip->getAxis("z"), routeEnd = (int)pShip->getRoute().size();
+    auto isChanged = [&state](int column){
+        for(auto& changed : state.changed)
+            if(changed.column == column)
+                return true;
+        return false;
+    };
+    auto usable = [&](int column){ return approved.test(column / Y, column % Y); };
+    std::vector<std::pair<int,int>> inOrder; /*(stop, column)*/
+    std::pair<int,int> outOfOrder(NO_COLUMN, NO_COLUMN);
+    for(auto& changed : state.changed){
+        if(changed.height >= Z || !usable(changed.column))
+            continue;
+        if(changed.minStop >= item.stop)
+            inOrder.emplace_back(changed.minStop, changed.column);
+        else
+            outOfOrder = std::max(outOfOrder, std::make_pair(changed.minStop, changed.column));
+    }
+    /*The skipped columns (changed or not approved) are bounded, the candidates are a heuristic anyway*/
+    int scanLimit = BEAM_DEPTH + BEAM_CANDIDATES;
+    auto first = freeColumns.lower_bound({item.stop, INT_MIN});
+    int taken = 0;
+    for(auto it = first; it != freeColumns.end() && it->first != NEVER_LEAVES && taken < 2 && scanLimit > 0; ++it, --scanLimit){
+        if(!isChanged(it->second) && usable(it->second)){
+            inOrder.push_back(*it);
+            taken++;
+        }
+    }
+    for(auto it = first; it != freeColumns.begin() && scanLimit > 0; --scanLimit){
+        --it;
+        if(!isChanged(it->second) && usable(it->second)){
+            outOfOrder = std::max(outOfOrder, *it);
+            break;
+        }
+    }
+    std::sort(inOrder.begin(), inOrder.end());
+    std::vector<int> candidates;
+    for(size_t i = 0; i < inOrder.size() && i < 2; i++)
+        candidates.push_back(inOrder[i].second);
+    int X = 0, emptyY = 0;
+    if(pShip->getPlacementEngine().findColumn(item.kg, NEVER_LEAVES, X, emptyY) && !isChanged(X * Y + emptyY) &&
+       indexedStops[X * Y + emptyY] == NEVER_LEAVES && usable(X * Y + emptyY))
+        candidates.push_back(X * Y + emptyY);
+    if(outOfOrder.second != NO_COLUMN)
+        candidates.push_back(outOfOrder.second);
+
+    for(int column : candidates){
+        ColumnState columnBefore = columnState(state, column);
+        BeamState child = state;
+        bool ordered = item.stop <= columnBefore.minStop;
+        child.rehandles += ordered ? 0 : 1;
+        child.slack += ordered ? std::min(columnBefore.minStop, routeEnd) - item.stop : 0;
+        ColumnState columnAfter{column, columnBefore.height + 1, std::min(columnBefore.minStop, item.stop)};
+        bool replaced = false;
+        for(auto& changed : child.changed){
+            if(changed.column == column){
+                changed = columnAfter;
+                replaced = true;
+            }
+        }
+        if(!replaced)
+            child.changed.push_back(columnAfter);
+        child.decisions.push_back(column);
+        children.emplace_back(std::move(child));
+    }
+}
+
+/**
+ * orders the states by their score, the decisions break ties so the order is total
+ */
+bool _313263204_d::betterState(const BeamState& a, const BeamState& b){
+    return std::tie(a.rehandles, a.slack, a.decisions) < std::tie(b.rehandles, b.slack, b.decisions);
+}
+
+/**
+ * runs the beam search over the decisions of items[first, first + BEAM_DEPTH), once the port's budget of states
+ * is out (or, as an emergency, it's deadline passed) only items[first] is decided (greedy).
+ * every candidate of items[first] is a plan searched by it's own beam on the search threads, the best plan is
+ * merged by betterState and the states each plan expanded are counted in it's own slot, so neither the column
+ * found nor the budget left depend on the number of threads.
+ * @return the column of the first decision of the best plan found, or NO_COLUMN if there's none
+ */
+int _313263204_d::searchColumn(const std::vector<Item>& items, size_t first){
+    bool searching = portExpansions < portBudget && std::chrono::steady_clock::now() < portDeadline;
+    size_t last = std::min(items.size(), first + (searching ? BEAM_DEPTH : 1));
+    std::vector<BalanceMask> approved;
+    for(size_t i = first; i < last; i++)
+        approved.push_back(calc.approvedColumns('L', items[i].kg));
+    std::vector<BeamState> plans;
+    expandState(BeamState(), items[first], approved[0], plans);
+    std::vector<long long> expanded(plans.size(), 0);
+    auto best = search->searchBest<BeamState>((int)plans.size(), [&](int plan, BeamState& result){
+        std::vector<BeamState> beam{plans[plan]};
+        for(size_t i = first + 1; i < last; i++){
+            std::vector<BeamState> children;
+            for(auto& state : beam)
+                expandState(state, items[i], approved[i - first], children);
+            expanded[plan] += (long long)children.size();
+            if(children.empty())
+                break;
+            if(children.size() > BEAM_WIDTH){
+                std::partial_sort(children.begin(), children.begin() + BEAM_WIDTH, children.end(), betterState);
+                children.resize(BEAM_WIDTH);
+            }
+            else
+                std::sort(children.begin(), children.end(), betterState);
+            beam.swap(children);
+        }
+        result = std::move(beam.front());
+        return true;
+    }, betterState);
+    portExpansions += (long long)plans.size();
+    for(long long count : expanded)
+        portExpansions += count;
+    return best ? best->decisions.front() : NO_COLUMN;
+}
+
+/**
+ * loads port's containers to ship by this scheme:
+ *      -sort containers by distance from destination and cut them to the free space in ship (orderLoad).
+ *      -load containers in reverse order (farthest first), each to the column the beam search finds over the
+ *       containers loaded after it (if the calculator declines it, to the column assignColumn finds).
+ * @param output - output file to write instructions for crane
+ */
+void _313263204_d::loadContainers(Type list_category, InstructionWriter& output){
+    std::vector<Container>* load = orderLoad(list_category, output);
+    if(load == nullptr) return;
+    /*The decisions to search over, in the order they are taken*/
+    auto route = pShip->getRoute();
+    std::vector<Item> items;
+    std::vector<bool> loadable(load->size(), false);
+    for(int i = (int)load->size() - 1; i >= 0; i--){
+        Container& con = (*load)[i];
+        if(isValidId(con.getId()) && isPortInRoute(con.getDest()->get_name(), route, portNum)){
+            loadable[i] = true;
+            items.push_back(Item{con.getWeight(), pShip->getStop(con.getDest(), portNum)});
+        }
+    }
+    int Y = pShip->getAxis("y");
+    size_t next = 0;
+    for(int i = (int)load->size() - 1; i >= 0; i--){
+        Container& con = (*load)[i];
+        bool loaded = false;
+        if(loadable[i]){
+            int column = searchColumn(items, next);
+            int stop = items[next++].stop;
+            coordinate coor(column / Y, column % Y);
+            bool found = column != NO_COLUMN && calc.probe('L', con.getWeight(), column / Y, column % Y) == APPROVED;
+            if(!found)
+                found = assignColumn(con.getWeight(), stop, coor);
+            if(found && !pShip->isOnShip(con) &&
+               calc.tryOperation('L', con.getWeight(), std::get<0>(coor), std::get<1>(coor)) == APPROVED){
+                pShip->addContainer(con, coor, stop);
+                reindexColumn(std::get<0>(coor), std::get<1>(coor));
+                writeToOutput(output, Action::LOAD, con.getId(),
+                              std::tuple<int,int,int>(std::get<0>(coor), std::get<1>(coor), pShip->getTopFloor(coor) - 1));
+                loaded = true;
+            }
+        }
+        if(!loaded)
+            writeToOutput(output, Action::REJECT, con.getId());
+    }
+    load->clear();
+}
+
+/**
+ * plans the port by ColumnIndexAlgorithm, the port's search budget and deadline start now
+ */
+int _313263204_d::getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) {
+    portExpansions = 0;
+    portDeadline = std::chrono::steady_clock::now() + portTimeCap;
+    return ColumnIndexAlgorithm::getInstructionsForCargo(input_full_path_and_file_name, output_full_path_and_file_name);
+}
@@ -0,0 +1,81 @@
+/**
+ * This module represents a route lookahead beam search algorithm.
+ * A container with stop s (the index in the route of the port it's unloaded at) placed on a column holding a
+ * container that leaves before s will be re-handled when the ship gets there, so simulating the remaining route over
+ * a column counts one re-handle for every container with a stop later than the lowest stop under it.
+ * The loads of a port are planned by a bounded beam search over the placement decisions (farthest stop first):
+ *      - a state is the columns changed by the decisions so far, scored by the simulated re-handles of it's
+ *        placements, then by their slack (how much later than the container the column leaves, lower keeps
+ *        the late leaving columns for later ports).
+ *      - every decision is expanded to at most BEAM_CANDIDATES columns (the closest in order stops, the most
+ *        balanced empty column, the latest out of order stop) and the best BEAM_WIDTH states are kept.
+ *      - the search is a rolling horizon of BEAM_DEPTH decisions, the first decision of the best state is taken.
+ * -budget: the search of a port stops once it expanded it's budget of states (anytime), the rest of the port's
+ *  decisions are taken greedily (closest in order stop), the budget is DEFAULT_PORT_EXPANSIONS states per port unless
+ *  set by the PORT_EXPANSIONS_ENV environment variable. the states are counted, not timed, so the instructions are
+ *  the same on every machine and with any number of threads.
+ * -deadline: an emergency cap on the time of a port, DEFAULT_PORT_DEADLINE_MS milliseconds unless set by the
+ *  PORT_DEADLINE_ENV environment variable, far above what the budget takes. only a port that reaches it (a slow or
+ *  overloaded machine) is cut by the clock, and then it's instructions depend on the speed of the search.
+ * -threads: the candidate plans of a decision are searched in parallel (ParallelSearch), the best plan is merged
+ *  deterministically so the instructions don't depend on the number of threads, the number of threads is the
+ *  number of cores unless set by the SEARCH_THREADS_ENV environment variable.
+ * The column index, the unloads and the fallback column (assignColumn) are the ones of ColumnIndexAlgorithm,
+ * the same as _313263204_c.
+ */
+
+#ifndef SHIP1_BEAM_SEARCH_ALGORITHM_H
+#define SHIP1_BEAM_SEARCH_ALGORITHM_H
+
+#include <chrono>
+#include <cstdlib>
+#include "ColumnIndexAlgorithm.h"
+#include "../common/ParallelSearch.h"
+
+#define BEAM_WIDTH 8
+#define BEAM_DEPTH 8
+#define BEAM_CANDIDATES 4
+#define DEFAULT_PORT_EXPANSIONS 20000
+#define PORT_EXPANSIONS_ENV "SHIP_PORT_EXPANSIONS"
+#define DEFAULT_PORT_DEADLINE_MS 10000
+#define PORT_DEADLINE_ENV "SHIP_PORT_DEADLINE_MS"
+#define SEARCH_THREADS_ENV "SHIP_SEARCH_THREADS"
+
+class _313263204_d: public ColumnIndexAlgorithm<_313263204_d> {
+    struct Item {
+        int kg;
+        int stop;
+    };
+    struct ColumnState {
+        int column;
+        int height;
+        int minStop;
+    };
+    struct BeamState {
+        long long rehandles = 0;
+        long long slack = 0;
+        std::vector<ColumnState> changed;
+        std::vector<int> decisions;
+    };
+    const std::string name = "_313263204_d";
+    long long portBudget = DEFAULT_PORT_EXPANSIONS;
+    long long portExpansions = 0; /*states expanded by the search of the current port*/
+    std::chrono::milliseconds portTimeCap{DEFAULT_PORT_DEADLINE_MS};
+    std::chrono::steady_clock::time_point portDeadline;
+    std::unique_ptr<ParallelSearch> search;
+public:
+    explicit _313263204_d();
+    ~_313263204_d() override= default;
+
+    /*-------------- Overriding Methods --------------*/
+    int getInstructionsForCargo(const std::string& input_full_path_and_file_name, const std::string& output_full_path_and_file_name) override;
+
+    /*-------------- Supporting Methods --------------*/
+    ColumnState columnState(const BeamState& state, int column) const;
+    void expandState(const BeamState& state, const Item& item, const BalanceMask& approved, std::vector<BeamState>& children) const;
+    static bool betterState(const BeamState& a, const BeamState& b);
+    int searchColumn(const std::vector<Item>& items, size_t first);
+    void loadContainers(Type list_category, InstructionWriter &output);
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "CargoDataTable.h"
+#include <algorithm>
+#include <functional>
+
+/**
+ * removes all lines and ids, the buffer, entries and slots keep their capacity for the next port
+ */
+void CargoDataTable::clear() {
+    buffer.clear();
+    entries.clear();
+    lines.clear();
+    sorted.clear();
+    sortedValid = false;
+    std::fill(slots.begin(), slots.end(), npos);
+}
+
+/**
+ * copies the file content to the shared line buffer, the lines added afterwards must be views into the returned copy
+ */
+std::string_view CargoDataTable::assign(std::string_view data) {
+    clear();
+    buffer.assign(data);
+    return buffer;
+}
+
+/**
+ * @return the slot of the given id, or the empty slot it should be inserted at
+ */
+int CargoDataTable::findSlot(std::string_view id, size_t hash) const {
+    size_t mask = slots.size() - 1;
+    for(size_t i = hash & mask;; i = (i + 1) & mask){
+        int entry = slots[i];
+        if(entry == npos || (entries[entry].hash == hash && entries[entry].id == id))
+            return (int)i;
+    }
+}
+
+/**
+ * doubles the slots (keeping the load factor at most 1/2) and reinserts all entries
+ */
+void CargoDataTable::grow() {
+    size_t capacity = slots.empty() ? 64 : slots.size() * 2;
+    slots.assign(capacity, npos);
+    for(int i = 0; i < (int)entries.size(); i++)
+        slots[findSlot(entries[i].id, entries[i].hash)] = i;
+}
+
+/**
+ * adds the line under the given id, both are views into the line buffer
+ * @return the index of the added line
+ */
+int CargoDataTable::addLine(std::string_view id, std::string_view line) {
+    if((entries.size() + 1) * 2 > slots.size())
+        grow();
+    size_t hash = std::hash<std::string_view>{}(id);
+    int slot = findSlot(id, hash);
+    int lineIndex = (int)lines.size();
+    lines.push_back({line, npos, false, false});
+    if(slots[slot] == npos){
+        slots[slot] = (int)entries.size();
+        entries.push_back({id, hash, lineIndex, lineIndex, 1, false});
+        sortedValid = false;
+    }
+    else {
+        Entry &entry = entries[slots[slot]];
+        lines[entry.lastLine].next = lineIndex;
+        entry.lastLine = lineIndex;
+        entry.size++;
+    }
+    return lineIndex;
+}
+
+int CargoDataTable::find(std::string_view id) const {
+    if(slots.empty()) return npos;
+    return slots[findSlot(id, std::hash<std::string_view>{}(id))];
+}
+
+bool CargoDataTable::contains(std::string_view id) const {
+    int entry = find(id);
+    return entry != npos && entries[entry].size > 0;
+}
+
+std::string_view CargoDataTable::front(int entry) const {
+    for(int i = entries[entry].firstLine; i != npos; i = lines[i].next)
+        if(!lines[i].erased)
+            return lines[i].text;
+    return std::string_view();
+}
+
+/**
+ * erases the last line left of the entry, a line equal to it is erased as well
+ */
+void CargoDataTable::eraseBack(int entry) {
+    std::string_view back;
+    forEachLine(entry, [&back](int, std::string_view text){ back = text; });
+    for(int i = entries[entry].firstLine; i != npos; i = lines[i].next){
+        if(!lines[i].erased && lines[i].text == back){
+            lines[i].erased = true;
+            entries[entry].size--;
+        }
+    }
+}
+
+void CargoDataTable::markRejected(int entry, int line) {
+    entries[entry].rejectTouched = true;
+    lines[line].rejected = true;
+}
+
+/**
+ * checks if a line of the entry equal to the given line was marked rejected (erased lines included), if so it's unmarked
+ */
+bool CargoDataTable::takeRejected(int entry, std::string_view line) {
+    bool found = false;
+    entries[entry].rejectTouched = true;
+    for(int i = entries[entry].firstLine; i != npos; i = lines[i].next){
+        if(lines[i].rejected && lines[i].text == line){
+            lines[i].rejected = false;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/**
+ * @return the entries sorted by their id, computed once per port
+ */
+const std::vector<int>& CargoDataTable::sortedEntries() {
+    if(!sortedValid){
+        sorted.resize(entries.size());
+        for(int i = 0; i < (int)entries.size(); i++)
+            sorted[i] = i;
+        std::sort(sorted.begin(), sorted.end(), [this](int a, int b){ return entries[a].id < entries[b].id; });
+        sortedValid = true;
+    }
+    return sorted;
+}
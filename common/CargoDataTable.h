@@ -0,0 +1,82 @@
+/**
+* This module represents the raw lines of a cargo_data file indexed by container id, used by the simulator validation.
+* the file content is copied once to a shared line buffer, lines and ids are views into it, and the ids are kept
+* in an open addressing (linear probing) hash table, all storage is kept by clear() so it's reused across ports.
+* each line may also be marked as rejected (the line must be rejected by the algorithm).
+*
+*      *******      Functions      ******
+* clear         - removes all lines and ids, keeps the allocated storage.
+* assign        - copies the given file content to the line buffer, returns a view to the copy.
+* addLine       - adds a line (a view into the line buffer) under the given id.
+* find          - returns the entry of the given id, or npos.
+* contains      - returns true iff the given id has lines left.
+* id            - returns the id of an entry.
+* front         - returns the first line left of an entry.
+* size          - returns the number of lines left of an entry.
+* eraseBack     - erases the last line left of an entry (and any other line left equal to it).
+* markRejected  - marks a line of an entry as rejected.
+* takeRejected  - checks if a line equal to the given one was marked rejected, and unmarks it.
+* hasRejected   - returns true iff an entry ever had a rejected line (or was looked up by takeRejected).
+* sortedEntries - returns the entries sorted by id.
+* forEachLine   - runs a given function over the lines left of an entry.
+*/
+#ifndef CARGO_DATA_TABLE_HEADER
+#define CARGO_DATA_TABLE_HEADER
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CargoDataTable {
+public:
+    static constexpr int npos = -1;
+
+private:
+    struct Entry {
+        std::string_view id;
+        size_t hash;
+        int firstLine;
+        int lastLine;
+        int size;
+        bool rejectTouched;
+    };
+    struct Line {
+        std::string_view text;
+        int next;
+        bool erased;
+        bool rejected;
+    };
+    std::string buffer;
+    std::vector<Entry> entries;
+    std::vector<Line> lines;
+    std::vector<int> slots;
+    std::vector<int> sorted;
+    bool sortedValid = false;
+
+    int findSlot(std::string_view id, size_t hash) const;
+    void grow();
+
+public:
+    void clear();
+    std::string_view assign(std::string_view data);
+    int addLine(std::string_view id, std::string_view line);
+    int find(std::string_view id) const;
+    bool contains(std::string_view id) const;
+    std::string_view front(int entry) const;
+    std::string_view id(int entry) const { return entries[entry].id; }
+    int size(int entry) const { return entries[entry].size; }
+    void eraseBack(int entry);
+    void markRejected(int entry, int line);
+    bool takeRejected(int entry, std::string_view line);
+    bool hasRejected(int entry) const { return entries[entry].rejectTouched; }
+    const std::vector<int>& sortedEntries();
+
+    template<typename Func>
+    void forEachLine(int entry, Func&& func) const {
+        for(int i = entries[entry].firstLine; i != npos; i = lines[i].next)
+            if(!lines[i].erased)
+                func(i, lines[i].text);
+    }
+};
+
+#endif
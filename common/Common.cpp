@@ -65,7 +65,7 @@ bool validateContainerData(const std::string& line, VALIDATION& reason, std::str
  * @return true iff it's valid port name
  */
 bool isValidPortName(const std::string& portName){
-    std::regex reg("\\s*[A-Za-z]{5}\\s*");
+    static const std::regex reg("\\s*[A-Za-z]{5}\\s*"); /*compiled once, it's checked for every cargo line*/
     return std::regex_match(portName, reg);
 }
 
@@ -110,7 +110,7 @@ std::vector<std::string> stringSplit(std::string s, const char* delimiter) {
  * @return true iff it's in the right format
  */
 bool isValidId(const std::string& str) {
-    std::regex reg("[A-Z]{3}[UJZ][0-9]{7}");
+    static const std::regex reg("[A-Z]{3}[UJZ][0-9]{7}"); /*compiled once, it's checked for every cargo line*/
     //return std::regex_match(str,reg);
     std::map<char,int> numericalValues;
     char curr;
@@ -150,15 +150,7 @@ bool isValidId(const std::string& str) {
  * @return true iff it already exist
  */
 bool idExistOnShip(const std::string& id, std::unique_ptr<Ship>& ship){
-    auto map = ship->getContainersByPort();
-    for(auto & pPort : map){
-        for(auto con_it : pPort.second) {
-            if(con_it.getId() == id){
-                return true;
-            }
-        }
-    }
-    return false;
+    return ship->isIdOnShip(id);
 }
 
 
@@ -184,32 +176,49 @@ bool isPortInRoute(const std::string& portName, const std::vector<std::shared_pt
     return found && portName != "NOT_IN_ROUTE";
 }
 
+/**
+ * This function collects the names of the following ports in the route from the current route location
+ * @param route
+ * @param portNum
+ * @return the names isPortInRoute(name, route, portNum) is true for
+ */
+std::unordered_set<std::string> getPortsInRoute(const std::vector<std::shared_ptr<Port>>& route, int portNum) {
+    std::unordered_set<std::string> names;
+    for(auto port_it = route.begin() + portNum + 1; port_it != route.end(); ++port_it)
+        names.insert((*port_it)->get_name());
+    names.erase(route[portNum]->get_name());
+    names.erase("NOT_IN_ROUTE");
+    return names;
+}
+
 /**
  * writes instruction for crane:
  * - REJECT: R, id
  * - MOVE: M, id, z1, x1, y1, z2, x2, y2
  * - LOAD / UNLOAD: L/U, id, z1, x1, y1
+ * the line is buffered by output, it reaches the file when the buffer fills or on output flush/close.
  */
-void writeToOutput(std::ofstream& output, AbstractAlgorithm::Action command, const std::string& id, const std::tuple<int,int,int> pos, const std::tuple<int,int,int>& movedTo){
+void writeToOutput(InstructionWriter& output, AbstractAlgorithm::Action command, const std::string& id, const std::tuple<int,int,int> pos, const std::tuple<int,int,int>& movedTo){
+    const std::string_view sep = ", ";
     int x1 = std::get<0>(pos), y1 = std::get<1>(pos), z1 = std::get<2>(pos);
     int x2 = std::get<0>(movedTo), y2 = std::get<1>(movedTo), z2 = std::get<2>(movedTo);
 
+    output.append(static_cast<char>(command));
+    output.append(sep);
+    output.append(id);
     switch(command) {
         case AbstractAlgorithm::Action::REJECT:
-            output << static_cast<char>(command) << ", " << id << std::endl;
             break;
         case AbstractAlgorithm::Action::MOVE:
-            output << static_cast<char>(command)
-            << ", " << id << ", " <<
-            z1 << ", " << x1 << ", " << y1 << ", " <<
-            z2 << ", " << x2 << ", " << y2 << std::endl;
+            output.append(sep); output.append(z1); output.append(sep); output.append(x1); output.append(sep); output.append(y1);
+            output.append(sep); output.append(z2); output.append(sep); output.append(x2); output.append(sep); output.append(y2);
             break;
         case  AbstractAlgorithm::Action::LOAD:
         case  AbstractAlgorithm::Action::UNLOAD:
-            output << static_cast<char>(command) << ", " << id << ", " <<
-            z1 << ", " << x1 << ", " << y1 << std::endl;
+            output.append(sep); output.append(z1); output.append(sep); output.append(x1); output.append(sep); output.append(y1);
             break;
     }
+    output.endLine();
 }
 
 
@@ -278,49 +287,8 @@ void initArrayOfErrors(std::array<bool,NUM_OF_ERRORS> &arr,int num){
 }
 
 bool isValidInteger(const std::string& str){
-    return std::regex_match(str, std::regex("[-|+]*[0-9]+"));
-}
-
-/**
- * This function creates a container based on instruction
- * @param sim - current simulator
- * @param rawData - map id --> container at port line
- * @param id - the container id we wish to create object
- * @param instruction - Load\Unload --> L\U
- * @param srcPortName - the source of the container
- * @return container.
- */
-std::unique_ptr<Container> createContainer(SimulatorObj* sim,map<string,list<string>> &rawData,string& id, string& instruction,string& srcPortName) {
-    vector<string> parsedInfo;
-    std::unique_ptr<Container> cont;
-    if (instruction == "L") {
-        auto srcPort = (sim->getShip()->getPortByName(srcPortName));
-        /*Case we load container exists in the raw Data*/
-        if (rawData.find(id) != rawData.end()) {
-            parsedInfo = stringSplit(rawData[id].front(), delim);
-            auto dstPort = (sim->getShip()->getPortByName(parsedInfo[2]));
-            int kg = atoi(parsedInfo[1].data());
-            cont = std::make_unique<Container>(id, kg, srcPort, dstPort);
-        }
-            /*Case we load container that unloaded before and now loaded*/
-        else {
-            for (auto &container : *sim->getPort()->getContainerVec(Type::PRIORITY))
-                if (container.getId() == id) {
-                    cont = std::make_unique<Container>(container.getId(), container.getWeight(),srcPort , container.getDest());
-                }
-
-        }
-    }
-    if(instruction == "U"){
-        std::tuple<int,int,int> tup = sim->getShip()->getCoordinate(id);
-        if(std::get<0>(tup) == -1 || std::get<1>(tup) == -1 || std::get<2>(tup) == -1)
-            return nullptr;
-        auto srcPort = (sim->getShip()->getPortByName(srcPortName));
-        auto &container = (sim->getShip()->getMap())[std::get<0>(tup)][std::get<1>(tup)][std::get<2>(tup)];
-        cont = std::make_unique<Container>(container.getId(),container.getWeight(),container.getDest(),srcPort);
-    }
-
-    return cont;
+    static const std::regex reg("[-|+]*[0-9]+"); /*compiled once, it's checked for every cargo line*/
+    return std::regex_match(str, reg);
 }
 
 /**
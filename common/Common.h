@@ -13,9 +13,9 @@
 * validateContainerData     - validates all container data given at line
 * idExistOnShip             - checks if given id already exist on ship map
 * isPortInRoute             - checks if a given port is already in route
+* getPortsInRoute           - the names of the ports isPortInRoute is true for
 * stringSplit               - split string to an array of string based on given delimiter
 * writeToOutput             - write's data to output file
-* createContainer           - creates container by searching it's id in the data
 * trimSpaces                - trim spaces from left and from right of a given string
  */
 
@@ -29,6 +29,7 @@ class SimulatorObj;
 #include <cmath>
 #include <string>
 #include <vector>
+#include <unordered_set>
 #include <list>
 #include <regex>
 #include <filesystem>
@@ -37,6 +38,7 @@ class SimulatorObj;
 #include "Ship.h"
 #include "Parser.h"
 #include "Port.h"
+#include "InstructionWriter.h"
 #include "../simulator/SimulatorObj.h"
 #include "../interfaces/ErrorsInterface.h"
 #include "../interfaces/WeightBalanceCalculator.h"
@@ -83,15 +85,15 @@ bool isValidId(const string& str);
 bool validateContainerData(const string& line, VALIDATION& reason, string& id, std::unique_ptr<Ship>& ship, std::array<bool,NUM_OF_ERRORS>& errorCodes);
 bool idExistOnShip(const string& id, std::unique_ptr<Ship>& ship);
 bool isPortInRoute(const string& portName, const vector<std::shared_ptr<Port>>& route, int portNum);
+std::unordered_set<string> getPortsInRoute(const vector<std::shared_ptr<Port>>& route, int portNum);
 
 /*----------------------Rest of the functions-------------------*/
 vector<string> stringSplit(string s, const char* delimiter);
-void writeToOutput(std::ofstream& output,
+void writeToOutput(InstructionWriter& output,
                    AbstractAlgorithm::Action command, const std::string& id,
                    const std::tuple<int,int,int> pos = std::forward_as_tuple(-1,-1,-1),
                    const std::tuple<int,int,int>& movedTo = std::forward_as_tuple(-1,-1,-1));
 void initArrayOfErrors(std::array<bool,NUM_OF_ERRORS> &arr,int num);
-std::unique_ptr<Container> createContainer(SimulatorObj* sim,map<string,list<string>> &rawData,string& id, string& instruction,string& srcPortName);
 void trimSpaces(string& toTrim);
 
 #endif
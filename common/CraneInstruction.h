@@ -0,0 +1,29 @@
+/**
+* This header represents a single decoded line of a crane instructions file.
+* decoding is done by decodeCraneInstruction at the Parser module.
+*/
+#ifndef CRANE_INSTRUCTION_HEADER
+#define CRANE_INSTRUCTION_HEADER
+
+#include <array>
+#include <string_view>
+
+/*----------------------Prefix variables-------------------*/
+#define MAX_INSTRUCTION_COORDINATES 6
+
+typedef std::array<int,MAX_INSTRUCTION_COORDINATES> craneCoordinates;
+enum class InstructionStatus {Valid, EmptyLine, BadAction, BadId, BadCoordinate, BadNumParameters};
+
+/**
+ * A decoded crane instruction line, id is a view into the decoded line so the line must outlive it.
+ * coordinates are ordered as written at the instruction: z1,x1,y1 (and z2,x2,y2 for move).
+ */
+struct CraneInstruction {
+    char action = '\0';
+    std::string_view id;
+    craneCoordinates coordinates{};
+    int numOfCoordinates = 0;
+    InstructionStatus status = InstructionStatus::EmptyLine;
+};
+
+#endif
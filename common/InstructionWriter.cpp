@@ -0,0 +1,122 @@
+#include "InstructionWriter.h"
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <cstdlib>
+
+#if !defined(WIN32) && !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#define RAW_WRITER_SUPPORTED
+#endif
+
+/**
+ * @return Raw if the WRITER_BACKEND_ENV environment variable is "raw", Stream otherwise, read once per process
+ */
+InstructionWriter::Backend InstructionWriter::defaultBackend() {
+    static const Backend backend = [](){
+        const char* name = std::getenv(WRITER_BACKEND_ENV);
+        return name != nullptr && std::strcmp(name, "raw") == 0 ? Backend::Raw : Backend::Stream;
+    }();
+    return backend;
+}
+
+InstructionWriter::InstructionWriter(Backend backend) : buffer(std::make_unique<char[]>(BUFFER_SIZE)), backend(backend) {
+#ifndef RAW_WRITER_SUPPORTED
+    this->backend = Backend::Stream;
+#endif
+}
+
+InstructionWriter::InstructionWriter(const std::string& path, Backend backend) : InstructionWriter(backend) {
+    open(path);
+}
+
+InstructionWriter::~InstructionWriter() {
+    close();
+}
+
+/**
+ * opens the given file for writing, any previously opened file is flushed and closed first
+ * @return true iff the file opened successfully
+ */
+bool InstructionWriter::open(const std::string& path) {
+    close();
+#ifdef RAW_WRITER_SUPPORTED
+    if(backend == Backend::Raw){
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        return fd != -1;
+    }
+#endif
+    stream.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    return stream.is_open();
+}
+
+bool InstructionWriter::isOpen() const {
+    return backend == Backend::Raw ? fd != -1 : stream.is_open();
+}
+
+void InstructionWriter::append(char ch) {
+    if(used == BUFFER_SIZE) flush();
+    buffer[used++] = ch;
+}
+
+/**
+ * copies str to the buffer, flushing as many times as needed for strings longer than the free space
+ */
+void InstructionWriter::append(std::string_view str) {
+    while(!str.empty()){
+        if(used == BUFFER_SIZE) flush();
+        size_t chunk = std::min(str.size(), BUFFER_SIZE - used);
+        std::memcpy(buffer.get() + used, str.data(), chunk);
+        used += chunk;
+        str.remove_prefix(chunk);
+    }
+}
+
+void InstructionWriter::append(int num) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), num);
+    append(std::string_view(digits, result.ptr - digits));
+}
+
+void InstructionWriter::endLine() {
+    append('\n');
+}
+
+/**
+ * writes the buffered data to the file, the only place that touches the file besides open/close
+ */
+void InstructionWriter::flush() {
+    if(used == 0) return;
+#ifdef RAW_WRITER_SUPPORTED
+    if(backend == Backend::Raw){
+        size_t written = 0;
+        while(fd != -1 && written < used){
+            ssize_t res = ::write(fd, buffer.get() + written, used - written);
+            if(res < 0){
+                if(errno == EINTR) continue;
+                break;
+            }
+            written += res;
+        }
+        used = 0;
+        return;
+    }
+#endif
+    if(stream.is_open())
+        stream.write(buffer.get(), used);
+    used = 0;
+}
+
+void InstructionWriter::close() {
+    flush();
+#ifdef RAW_WRITER_SUPPORTED
+    if(fd != -1){
+        ::close(fd);
+        fd = -1;
+    }
+#endif
+    if(stream.is_open())
+        stream.close();
+}
@@ -0,0 +1,62 @@
+/**
+* This module represents a buffered writer of a crane instructions file.
+* instructions are formatted into a large user space buffer which is written to the file only when it's full,
+* or explicitly by flush/close at the end of the port, instead of a write per instruction line.
+* -backend:
+*   # Stream - the buffer is written through std::ofstream.
+*   # Raw    - the buffer is written with write(2) directly to the file descriptor (POSIX only, else Stream).
+*   the default backend is Stream, or Raw if the WRITER_BACKEND_ENV environment variable is set to "raw".
+*
+*      *******      Functions      ******
+* defaultBackend - returns the backend chosen by WRITER_BACKEND_ENV.
+* open      - opens (truncates) the given file path, flushing and closing the previous one if any.
+* isOpen    - returns true iff there's an opened file.
+* append    - appends a char/string/int to the buffer.
+* endLine   - appends a line break to the buffer.
+* flush     - writes the buffer to the file.
+* close     - flushes and closes the file.
+*
+*/
+#ifndef INSTRUCTION_WRITER_HEADER
+#define INSTRUCTION_WRITER_HEADER
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <memory>
+
+#define WRITER_BACKEND_ENV "SHIP_INSTRUCTION_WRITER"
+
+class InstructionWriter {
+public:
+    enum class Backend {Stream, Raw};
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+private:
+    std::unique_ptr<char[]> buffer;
+    size_t used = 0;
+    Backend backend;
+    std::ofstream stream;
+    int fd = -1;
+
+public:
+    /*C'tors*/
+    explicit InstructionWriter(Backend backend = defaultBackend());
+    explicit InstructionWriter(const std::string& path, Backend backend = defaultBackend());
+    InstructionWriter(const InstructionWriter&) = delete;
+    InstructionWriter& operator=(const InstructionWriter&) = delete;
+    ~InstructionWriter();
+
+    static Backend defaultBackend();
+
+    bool open(const std::string& path);
+    bool isOpen() const;
+    void append(char ch);
+    void append(std::string_view str);
+    void append(int num);
+    void endLine();
+    void flush();
+    void close();
+};
+
+#endif
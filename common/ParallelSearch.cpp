@@ -0,0 +1,121 @@
+#include "ParallelSearch.h"
+#include <algorithm>
+
+/**
+ * starts numThreads - 1 threads (the calling thread of run is the last one), at least one thread searches
+ */
+ParallelSearch::ParallelSearch(int numThreads): numThreads(std::max(numThreads, 1)), queues(this->numThreads) {
+    for(int i = 1; i < this->numThreads; i++)
+        threads.emplace_back(&ParallelSearch::threadLoop, this, i);
+}
+
+ParallelSearch::~ParallelSearch() {
+    {
+        std::lock_guard<std::mutex> guard(poolLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for(auto& thread : threads)
+        thread.join();
+}
+
+/**
+ * a pool thread waits for a search to start, works on it and waits for the next one
+ */
+void ParallelSearch::threadLoop(int self) {
+    unsigned long long seen = 0;
+    while(true){
+        const std::function<void(int)>* task = nullptr;
+        {
+            std::unique_lock<std::mutex> guard(poolLock);
+            wakeUp.wait(guard, [this, seen](){ return stopping || generation != seen; });
+            if(stopping)
+                return;
+            seen = generation;
+            task = currentTask;
+            if(task == nullptr) /*woke up after the search already finished*/
+                continue;
+            busyThreads++;
+        }
+        work(self, *task);
+        {
+            std::lock_guard<std::mutex> guard(poolLock);
+            busyThreads--;
+        }
+        finished.notify_all();
+    }
+}
+
+/**
+ * takes the next task of the thread: it's own last one, or else the first task of another thread's queue
+ * @return false iff there are no tasks left to take
+ */
+bool ParallelSearch::nextTask(int self, int& index) {
+    {
+        std::lock_guard<std::mutex> guard(queues[self].lock);
+        if(!queues[self].tasks.empty()){
+            index = queues[self].tasks.back();
+            queues[self].tasks.pop_back();
+            return true;
+        }
+    }
+    for(int i = 1; i < numThreads; i++){
+        TaskQueue& victim = queues[(self + i) % numThreads];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.tasks.empty()){
+            index = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ParallelSearch::work(int self, const std::function<void(int)>& task) {
+    int index = 0;
+    while(remainingTasks > 0 && nextTask(self, index)){
+        try {
+            task(index);
+        }
+        catch(...){
+            std::lock_guard<std::mutex> guard(poolLock);
+            if(!firstException) firstException = std::current_exception();
+        }
+        remainingTasks--;
+    }
+}
+
+/**
+ * This function runs task(0)...task(numOfTasks-1) over the pool, the calling thread included,
+ * the first exception thrown by a task is rethrown at the calling thread after all tasks finished.
+ * a single task (or a single thread) is run at the calling thread without waking the pool.
+ */
+void ParallelSearch::run(int numOfTasks, const std::function<void(int)>& task) {
+    if(numOfTasks <= 0)
+        return;
+    if(numThreads == 1 || numOfTasks == 1){
+        for(int i = 0; i < numOfTasks; i++)
+            task(i);
+        return;
+    }
+    for(int i = 0; i < numOfTasks; i++)
+        queues[i % numThreads].tasks.push_back(i);
+    remainingTasks = numOfTasks;
+    {
+        std::lock_guard<std::mutex> guard(poolLock);
+        currentTask = &task;
+        firstException = nullptr;
+        generation++;
+    }
+    wakeUp.notify_all();
+    work(0, task);
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> guard(poolLock);
+        finished.wait(guard, [this](){ return remainingTasks == 0 && busyThreads == 0; });
+        currentTask = nullptr;
+        exception = firstException;
+    }
+    if(exception)
+        std::rethrow_exception(exception);
+}
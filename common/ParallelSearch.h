@@ -0,0 +1,81 @@
+/**
+* This module represents a pool of search threads an algorithm can split the planning of a port over.
+* the pool's threads are started once and reused by every search, a search is a list of indexed tasks
+* (e.g. the candidate plans of a decision) run by the calling thread and the pool's threads.
+* -work stealing: the tasks are dealt round robin to per thread queues, a thread runs it's own queue from the back
+*  and when it's empty steals from the front of the other queues, so uneven plans don't leave threads idle.
+* -deterministic merge: every task writes only to it's own result slot and the slots are merged by task index,
+*  so the result of a search doesn't depend on the number of threads or on which thread ran which task.
+*
+*      *******      Functions      ******
+* getNumThreads - returns the number of threads searching (the calling thread included).
+* run           - runs task(0)...task(numOfTasks-1) over the pool, returns when all of them finished.
+* searchBest    - runs a search per candidate and returns the best result found, ties go to the lower candidate.
+*
+*/
+#ifndef PARALLEL_SEARCH_HEADER
+#define PARALLEL_SEARCH_HEADER
+
+#include <vector>
+#include <deque>
+#include <optional>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+class ParallelSearch {
+    /*a thread's queue of task indexes, the owner pops from the back and thieves from the front*/
+    struct TaskQueue {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+    int numThreads;
+    std::vector<std::thread> threads;
+    std::vector<TaskQueue> queues;
+    std::mutex poolLock;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+    const std::function<void(int)>* currentTask = nullptr;
+    unsigned long long generation = 0; /*number of searches started, wakes the threads*/
+    int busyThreads = 0;
+    bool stopping = false;
+    std::atomic<int> remainingTasks{0};
+    std::exception_ptr firstException;
+
+    void threadLoop(int self);
+    void work(int self, const std::function<void(int)>& task);
+    bool nextTask(int self, int& index);
+
+public:
+    explicit ParallelSearch(int numThreads);
+    ~ParallelSearch();
+    ParallelSearch(const ParallelSearch&) = delete;
+    ParallelSearch& operator=(const ParallelSearch&) = delete;
+
+    int getNumThreads() const { return numThreads; }
+    void run(int numOfTasks, const std::function<void(int)>& task);
+
+    /**
+     * runs search(i, result) for every candidate i in [0, numOfCandidates), search returns true iff it found a result.
+     * @return the best result by less among the candidates that found one, ties go to the lower candidate index
+     */
+    template<typename Result, typename Search, typename Less>
+    std::optional<Result> searchBest(int numOfCandidates, const Search& search, const Less& less){
+        std::vector<std::optional<Result>> results(numOfCandidates);
+        run(numOfCandidates, [&results, &search](int index){
+            Result result;
+            if(search(index, result))
+                results[index] = std::move(result);
+        });
+        std::optional<Result> best;
+        for(auto& result : results)
+            if(result && (!best || less(*result, *best)))
+                best = std::move(result);
+        return best;
+    }
+};
+
+#endif
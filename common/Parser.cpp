@@ -1,4 +1,6 @@
 #include "Parser.h"
+#include <charconv>
+#include <cctype>
 
 /**
  * This function gets the number from the <port_symbol>_<num>.<filetype> deceleration
@@ -176,8 +178,11 @@ int extractShipPlan(const std::string& filePath, std::unique_ptr<Ship>& ship){
 /**
  * This function parse the ship map and the ship route files and init a new ship object with
  * the information it parsed.
+ * the simulator error codes found while parsing are accumulated at simErrorCodes, it touches nothing but the given
+ * travel so it can run concurrently for different travels.
  */
-std::unique_ptr<Ship> extractArgsForShip(std::unique_ptr<Travel> &travel,SimulatorObj &simulator) {
+std::unique_ptr<Ship> extractArgsForShip(std::unique_ptr<Travel> &travel,int &simErrorCodes) {
+    const int fatalErrors = Plan_Fatal | Plan_Con | Route_Fatal | Route_SingleP;
     string file_path;
     vector<std::shared_ptr<Port>> travelRoute;
     std::unique_ptr<Ship> ship;
@@ -194,13 +199,13 @@ std::unique_ptr<Ship> extractArgsForShip(std::unique_ptr<Travel> &travel,Simulat
     int resultInt = extractShipPlan(file_path,ship);
     if(resultInt == 0){
         resultInt = extractArgsForBlocks(ship,file_path,&travel);
-        simulator.updateErrorCodes(resultInt, "sim");
-        if(simulator.checkIfFatalErrorOccurred("sim") == -1)
+        simErrorCodes |= resultInt;
+        if(simErrorCodes & fatalErrors)
             return nullptr;
     }
     else {
         travel->setNewGeneralError(ERROR_FATA_LPLAN);
-        simulator.updateErrorCodes(resultInt, "sim");
+        simErrorCodes |= resultInt;
         return nullptr;
     }
     /*Handle ship route file*/
@@ -214,36 +219,74 @@ std::unique_ptr<Ship> extractArgsForShip(std::unique_ptr<Travel> &travel,Simulat
         return nullptr;
     }
     SimulatorObj::compareRoutePortsVsCargoDataPorts(ship,travel);
-    simulator.updateErrorCodes(resultInt, "sim");
+    simErrorCodes |= resultInt;
     return ship;
 }
 
 
 /**
- * This function parses the data from a port file, it saves it by container id and the data line of this id in a map
+ * This function parses the data from a port file, it saves it by container id and the data line of this id in the table
  */
-void extractRawDataFromPortFile(std::map<string,list<string>>& map, string& inputPath,SimulatorObj* sim){
-    std::ifstream inFile;
-    string line;
+void extractRawDataFromPortFile(CargoDataTable& table, string& inputPath,SimulatorObj* sim){
+    /*Case we are in the last stop, dont read anything*/
+    if(sim->getPortNum() == (int)sim->getShip()->getRoute().size()-1)
+        return;
+    extractRawDataFromPortFile(table, inputPath, readFileToMemory(inputPath), sim);
+}
+
+/**
+ * This function checks if a cargo_data line is a comment or a white spaces line, same as isCommentLine without copying the line
+ */
+static bool isCargoCommentLine(std::string_view line){
+    auto cntrl = std::find_if(line.begin(), line.end(), [](unsigned char ch){ return iscntrl(ch); });
+    line = line.substr(0, cntrl - line.begin());
+    auto first = std::find_if(line.begin(), line.end(), [](unsigned char ch){ return !isspace(ch); });
+    return first == line.end() || *first == '#';
+}
+
+/**
+ * This function extracts the container id of a cargo_data line, same as the first word of stringSplit without copying the line
+ */
+static std::string_view extractCargoLineId(std::string_view line){
+    while(!line.empty() && isspace((unsigned char)line.front())) line.remove_prefix(1);
+    while(!line.empty() && isspace((unsigned char)line.back())) line.remove_suffix(1);
+    if(!line.empty() && iscntrl((unsigned char)line.back())) line.remove_suffix(1);
+    return line.substr(0, line.find_first_of(delim));
+}
+
+/**
+ * overloaded function that parses the port file data already read to memory (nullopt if reading failed),
+ * the data is copied once to the table line buffer and the lines are indexed without further copies
+ */
+void extractRawDataFromPortFile(CargoDataTable& table, string& inputPath, const std::optional<string>& fileData, SimulatorObj* sim){
     /*Case we are in the last stop, dont read anything*/
     if(sim->getPortNum() == (int)sim->getShip()->getRoute().size()-1)
         return;
-    inFile.open(inputPath);
-    if(inFile.fail()){
+    if(!fileData){
         ERROR_READ_PATH(inputPath);
         return;
     }
-    while(getline(inFile,line)){
-        if(isCommentLine(line))continue;
-        vector<string> parsedInfo = stringSplit(line,delim);
-        string contID = parsedInfo.at(0);
-        if(map.find(contID) == map.end()){
-            list<string> ls;
-            map.insert(make_pair(contID,ls));
-        }
-        map[contID].emplace_back(line);
+    std::string_view data = table.assign(*fileData);
+    while(!data.empty()){
+        size_t end = data.find('\n');
+        std::string_view line = data.substr(0, end);
+        data.remove_prefix(end == std::string_view::npos ? data.size() : end + 1);
+        if(isCargoCommentLine(line))continue;
+        table.addLine(extractCargoLineId(line), line);
     }
-    inFile.close();
+}
+
+/**
+ * This function reads the whole file to memory
+ * @return the file content, or nullopt if the file can't be read
+ */
+std::optional<string> readFileToMemory(const string& filePath){
+    std::ifstream inFile(filePath, std::ios::in | std::ios::binary);
+    if(inFile.fail())
+        return std::nullopt;
+    std::ostringstream content;
+    content << inFile.rdbuf();
+    return content.str();
 }
 
 
@@ -251,7 +294,7 @@ void extractRawDataFromPortFile(std::map<string,list<string>>& map, string& inpu
  * Parses the containers data and connecting it to the "load" list of the port.
  * Updates errors code.
  */
-bool parseDataToPort(const std::string& inputFullPathAndFileName, std::ofstream &output,
+bool parseDataToPort(const std::string& inputFullPathAndFileName, InstructionWriter &output,
         std::unique_ptr<Ship>& ship, std::shared_ptr<Port>& port, std::set<std::string>& idSet, std::array<bool,NUM_OF_ERRORS>& errorCodes, bool lastPort) {
     std::string line;
     std::ifstream input;
@@ -294,18 +337,69 @@ bool parseDataToPort(const std::string& inputFullPathAndFileName, std::ofstream
 }
 
 /**
- * This function gets a string to extract the data from and arrange it.
+ * This function checks if a given char separates tokens at a crane instruction line
  */
-void extractCraneInstruction(string &toParse, string& instruction, string& id, vector<int> &coordinates){
-    auto parsedInfo = stringSplit(toParse,delim);
-    for(int i = 0; i < (int)parsedInfo.size(); i++){
-        if(i == 0)
-            instruction = parsedInfo.at(0);
-        else if(i == 1)
-            id = parsedInfo.at(1);
-        else
-            coordinates.emplace_back(stoi(parsedInfo.at(i)));
+static bool isInstructionDelimiter(char ch){
+    return ch == ',' || std::isspace(static_cast<unsigned char>(ch)) || std::iscntrl(static_cast<unsigned char>(ch));
+}
+
+/**
+ * This function sets token to be the next token of line starting at pos and advances pos beyond it
+ * @return false iff there are no more tokens at line
+ */
+static bool nextInstructionToken(std::string_view line, size_t& pos, std::string_view& token){
+    while(pos < line.size() && isInstructionDelimiter(line[pos])) ++pos;
+    if(pos == line.size()) return false;
+    size_t start = pos;
+    while(pos < line.size() && !isInstructionDelimiter(line[pos])) ++pos;
+    token = line.substr(start, pos - start);
+    return true;
+}
+
+/**
+ * This function decodes a crane instruction line: <L/U/M/R>, id, [z1, x1, y1, [z2, x2, y2]]
+ * (a reject has no coordinates or three ignored ones)
+ * in a single pass over the line and without allocating, the result and the parse status are set at instruction.
+ * @return true iff the line is a well formed instruction
+ */
+bool decodeCraneInstruction(std::string_view line, CraneInstruction& instruction){
+    size_t pos = 0;
+    std::string_view token;
+    instruction = CraneInstruction();
+
+    if(!nextInstructionToken(line, pos, token))
+        return false; /*status is EmptyLine*/
+    if(token.size() != 1 || (token[0] != 'L' && token[0] != 'U' && token[0] != 'M' && token[0] != 'R')){
+        instruction.status = InstructionStatus::BadAction;
+        return false;
+    }
+    instruction.action = token[0];
+    if(!nextInstructionToken(line, pos, instruction.id)){
+        instruction.status = InstructionStatus::BadId;
+        return false;
     }
+    while(nextInstructionToken(line, pos, token)){
+        if(instruction.numOfCoordinates == MAX_INSTRUCTION_COORDINATES){
+            instruction.status = InstructionStatus::BadNumParameters;
+            return false;
+        }
+        if(token.size() > 1 && token[0] == '+') token.remove_prefix(1);
+        int& value = instruction.coordinates[instruction.numOfCoordinates++];
+        auto [end, err] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if(err != std::errc() || end != token.data() + token.size()){
+            instruction.status = InstructionStatus::BadCoordinate;
+            return false;
+        }
+    }
+    /*a reject may carry the (ignored) coordinates of the rejected container, e.g. R, id, -1, -1, -1*/
+    bool rejectCoordinates = instruction.action == 'R' && instruction.numOfCoordinates == 3;
+    int expected = instruction.action == 'R' ? 0 : (instruction.action == 'M' ? 6 : 3);
+    if(instruction.numOfCoordinates != expected && !rejectCoordinates){
+        instruction.status = InstructionStatus::BadNumParameters;
+        return false;
+    }
+    instruction.status = InstructionStatus::Valid;
+    return true;
 }
 
 /**
@@ -5,14 +5,15 @@
 *      *******      Functions      *******
 * extractPortNumFromFile    - extracts the number from port file
 * extractArgsForBlocks      - extracts the arguments for container blocks
-* extractCraneInstruction   - extracts crane instruction from crane instruction file
+* decodeCraneInstruction    - decodes a crane instruction line in a single pass without allocating
 * extractContainersData     - extracts container data from cargo_data file line
 * extractTravelRoute        - extracts the travel route parameters
 * extractArgsForShip        - extracts the whole arguments to build ship map
 * setBlocksByLine           - setting container blocks by line from file
 * getDimensions             - getting the dimensions from a line
 * portAlreadyExist          - checks if port already occured previously
-* extractRawDataFromPortFile - extracts the whole data from the cargo_data file into map
+* extractRawDataFromPortFile - extracts the whole data from the cargo_data file into the cargo data table
+* readFileToMemory          - reads a whole file into a string
 * parseDataToPort           - parsing the data from cargo_data file
 * extractShipPlan           - extracts the ship plan
 * extractPortNameFromFile   - extracts port name from port file
@@ -32,7 +33,12 @@ class Common;
 #include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <optional>
 #include "Common.h"
+#include "CraneInstruction.h"
+#include "InstructionWriter.h"
+#include "CargoDataTable.h"
 #include "../interfaces/ErrorsInterface.h"
 #include "../simulator/Travel.h"
 
@@ -49,16 +55,18 @@ namespace fs = std::filesystem;
 int extractPortNumFromFile(const string& fileName);
 int extractArgsForBlocks(std::unique_ptr<Ship>& ship, const std::string& file_path,std::unique_ptr<Travel>* travel);
 int extractArgsForBlocks(std::unique_ptr<Ship>& ship,const std::string& filePath);
-void extractCraneInstruction(string &toParse, string& instruction, string& id, vector<int> &coordinates);
+bool decodeCraneInstruction(std::string_view line, CraneInstruction& instruction);
 void extractContainersData(const std::string& line, std::string &id, int &weight, std::shared_ptr<Port>& dest, std::unique_ptr<Ship>& ship);
 int extractTravelRoute(std::unique_ptr<Ship>& ship, const std::string& filePath);//Overload
 int extractTravelRoute(std::unique_ptr<Ship>& ship, const std::string& filePath,std::unique_ptr<Travel>* travel);
-std::unique_ptr<Ship> extractArgsForShip(std::unique_ptr<Travel> &travel,SimulatorObj &simulator);
+std::unique_ptr<Ship> extractArgsForShip(std::unique_ptr<Travel> &travel,int &simErrorCodes);
 pair<string,int> setBlocksByLine(std::string &str, std::unique_ptr<Ship> &ship,int lineNumber);
 void getDimensions(std::array<int,3> &arr, std::istream &inFile,string str);
 int portAlreadyExist(std::vector<std::shared_ptr<Port>>& vec,string &str);
-void extractRawDataFromPortFile(std::map<string,list<string>>& map, string &inputPath,SimulatorObj* sim);
-bool parseDataToPort(const std::string& inputFullPathAndFileName, std::ofstream &output,
+void extractRawDataFromPortFile(CargoDataTable& table, string &inputPath,SimulatorObj* sim);
+void extractRawDataFromPortFile(CargoDataTable& table, string &inputPath, const std::optional<string>& fileData, SimulatorObj* sim);
+std::optional<string> readFileToMemory(const string& filePath);
+bool parseDataToPort(const std::string& inputFullPathAndFileName, InstructionWriter &output,
                      std::unique_ptr<Ship>& ship, std::shared_ptr<Port>& port, std::set<std::string>& idSet, std::array<bool,NUM_OF_ERRORS>& errorCodes, bool lastPort);
 int extractShipPlan(const std::string& filePath, std::unique_ptr<Ship>& ship);
 string extractPortNameFromFile(const string& fileName);
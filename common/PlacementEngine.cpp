@@ -0,0 +1,188 @@
+#include "PlacementEngine.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    /**
+     * @return the index in [lo, hi] of the node's subtree that is the first (forward) / last (backward) index
+     * on that side of from holding at least value, or NO_COLUMN
+     */
+    int search(const std::vector<int>& tree, int node, int lo, int hi, int from, int value, bool forward){
+        if(tree[node] < value || (forward && hi < from) || (!forward && lo > from))
+            return NO_COLUMN;
+        if(lo == hi)
+            return lo;
+        int mid = (lo + hi) / 2;
+        int first = forward ? 2 * node : 2 * node + 1, second = forward ? 2 * node + 1 : 2 * node;
+        int found = forward ? search(tree, first, lo, mid, from, value, forward) :
+                              search(tree, first, mid + 1, hi, from, value, forward);
+        if(found != NO_COLUMN)
+            return found;
+        return forward ? search(tree, second, mid + 1, hi, from, value, forward) :
+                         search(tree, second, lo, mid, from, value, forward);
+    }
+}
+
+void PlacementEngine::MaxTree::init(int n) {
+    size = 1;
+    while(size < n)
+        size <<= 1;
+    tree.assign(2 * size, NO_COLUMN);
+}
+
+void PlacementEngine::MaxTree::set(int i, int value) {
+    i += size;
+    tree[i] = value;
+    for(i >>= 1; i >= 1; i >>= 1)
+        tree[i] = std::max(tree[2 * i], tree[2 * i + 1]);
+}
+
+/**
+ * @return the lowest index >= from holding at least value, or NO_COLUMN
+ */
+int PlacementEngine::MaxTree::nextAtLeast(int from, int value) const {
+    return tree.empty() ? NO_COLUMN : search(tree, 1, 0, size - 1, from, value, true);
+}
+
+/**
+ * @return the highest index <= from holding at least value, or NO_COLUMN
+ */
+int PlacementEngine::MaxTree::prevAtLeast(int from, int value) const {
+    return tree.empty() ? NO_COLUMN : search(tree, 1, 0, size - 1, from, value, false);
+}
+
+/**
+ * indexes the ship map, blocks never leave and any other container already on the ship is given unknownStop
+ */
+void PlacementEngine::build(std::vector<std::vector<std::vector<Container>>>& shipMap, int z, int unknownStop) {
+    dimX = (int)shipMap.size();
+    dimY = dimX > 0 ? (int)shipMap[0].size() : 0;
+    dimZ = z;
+    columns.assign(dimX * dimY, Column());
+    rows.assign(dimX, MaxTree());
+    rowMaxima.init(dimX);
+    totalWeight = momentX = momentY = 0;
+    for(int x = 0; x < dimX; x++){
+        rows[x].init(dimY);
+        for(int y = 0; y < dimY; y++){
+            for(auto& con : shipMap[x][y]){
+                bool block = con.getId() == "block";
+                push(x, y, block ? 0 : con.getWeight(), block ? NEVER_LEAVES : unknownStop);
+            }
+            update(x, y);
+        }
+    }
+}
+
+/**
+ * re-indexes the column after it changed
+ */
+void PlacementEngine::update(int x, int y) {
+    int stop = getStop(x, y);
+    rows[x].set(y, stop);
+    rowMaxima.set(x, rows[x].max());
+}
+
+void PlacementEngine::push(int x, int y, int kg, int stop) {
+    Column& col = column(x, y);
+    kg = std::max(kg, 0);
+    col.weights.push_back(kg);
+    col.stops.push_back(stop);
+    col.minStops.push_back(col.minStops.empty() ? stop : std::min(stop, col.minStops.back()));
+    totalWeight += kg;
+    momentX += (long long)kg * (2 * x - (dimX - 1));
+    momentY += (long long)kg * (2 * y - (dimY - 1));
+    update(x, y);
+}
+
+void PlacementEngine::pop(int x, int y) {
+    Column& col = column(x, y);
+    if(col.weights.empty())
+        return;
+    int kg = col.weights.back();
+    col.weights.pop_back();
+    col.stops.pop_back();
+    col.minStops.pop_back();
+    totalWeight -= kg;
+    momentX -= (long long)kg * (2 * x - (dimX - 1));
+    momentY -= (long long)kg * (2 * y - (dimY - 1));
+    update(x, y);
+}
+
+/**
+ * @return (weight, stop) of the top container of the column
+ */
+std::tuple<int,int> PlacementEngine::top(int x, int y) const {
+    const Column& col = column(x, y);
+    if(col.weights.empty())
+        return std::tuple<int,int>(0, NEVER_LEAVES);
+    return std::tuple<int,int>(col.weights.back(), col.stops.back());
+}
+
+void PlacementEngine::setExcluded(int x, int y, bool excluded) {
+    column(x, y).excluded = excluded;
+    update(x, y);
+}
+
+/**
+ * @return the stop of the column for the search: NO_COLUMN if it's full or excluded, NEVER_LEAVES if it's empty
+ */
+int PlacementEngine::getStop(int x, int y) const {
+    const Column& col = column(x, y);
+    if(col.excluded || (int)col.weights.size() >= dimZ)
+        return NO_COLUMN;
+    return col.minStops.empty() ? NEVER_LEAVES : col.minStops.back();
+}
+
+/**
+ * @return the distance (in half columns) of the center of mass from the ship center, summed over both axis,
+ * after loading kg to (x,y)
+ */
+double PlacementEngine::offsetAfter(int x, int y, int kg) const {
+    long long total = totalWeight + kg;
+    if(total <= 0)
+        return 0;
+    long long newMomentX = momentX + (long long)kg * (2 * x - (dimX - 1));
+    long long newMomentY = momentY + (long long)kg * (2 * y - (dimY - 1));
+    return (double)(std::llabs(newMomentX) + std::llabs(newMomentY)) / (double)total;
+}
+
+/**
+ * finds a column to load kg to that leaves the center of mass near the ship center. it's a heuristic, not a search
+ * for the closest: the target is the column that zeroes the moments, only the nearest rows to it on both sides and
+ * the nearest columns to it at those rows are compared (by the offset they leave), among the columns kg with stop
+ * is stacked in order on, or if there's none, among all the columns that aren't full.
+ * @return true iff a column was found, it's coordinate is set to (x,y)
+ */
+bool PlacementEngine::findColumn(int kg, int stop, int& x, int& y) const {
+    kg = std::max(kg, 0);
+    auto target = [kg](long long moment, int dim){
+        if(kg == 0)
+            return (dim - 1) / 2;
+        long long t = std::llround(((double)(dim - 1) - (double)moment / kg) / 2);
+        return (int)std::clamp(t, 0LL, (long long)dim - 1);
+    };
+    int targetX = target(momentX, dimX), targetY = target(momentY, dimY);
+    for(int required : {stop, 0}){
+        double best = -1;
+        int candidatesX[] = {rowMaxima.prevAtLeast(targetX, required), rowMaxima.nextAtLeast(targetX, required)};
+        for(int cx : candidatesX){
+            if(cx == NO_COLUMN || cx >= dimX)
+                continue;
+            int candidatesY[] = {rows[cx].prevAtLeast(targetY, required), rows[cx].nextAtLeast(targetY, required)};
+            for(int cy : candidatesY){
+                if(cy == NO_COLUMN || cy >= dimY)
+                    continue;
+                double offset = offsetAfter(cx, cy, kg);
+                if(best < 0 || offset < best){
+                    best = offset;
+                    x = cx;
+                    y = cy;
+                }
+            }
+        }
+        if(best >= 0)
+            return true;
+    }
+    return false;
+}
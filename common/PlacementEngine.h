@@ -0,0 +1,75 @@
+/**
+* This module represents an index of the ship's columns used to choose where to place a container.
+* it keeps the height (number of floors used), the weight and the stop stack of every column and the ship's
+* X and Y moments (same as the WeightBalanceCalculator, kg * (2x - (dimX - 1))), updated on every push/pop.
+* -stop: the index in the route of the port a container is unloaded at, a column's stop is the lowest stop
+*  of it's containers (blocks never leave), so a container with stop s is stacked in order on a column iff s <= it's stop.
+* -search: every row (x) has a max segment tree over it's columns' stops (full or excluded columns are NO_COLUMN)
+*  and the rows are indexed by a max segment tree over their maxima, so the nearest row and column to a target
+*  holding a given stop are found in O(log X + log Y).
+*
+*      *******      Functions      ******
+* build         - indexes the given ship map (containers already on it are given unknownStop).
+* push          - registers a container loaded to the top of a column.
+* pop           - registers the top container of a column was unloaded.
+* top           - returns the weight and stop of the top container of a column.
+* setExcluded   - excludes/includes a column from the search.
+* findColumn    - returns a column that keeps the ship balanced when loading kg (near the best one), preferring stacking order.
+* getStop       - returns the stop of a column.
+* getHeight     - returns the number of floors used at a column.
+*
+*/
+#ifndef PLACEMENT_ENGINE_HEADER
+#define PLACEMENT_ENGINE_HEADER
+
+#include <vector>
+#include <tuple>
+#include <climits>
+#include "Container.h"
+
+#define NO_COLUMN -1
+#define NEVER_LEAVES INT_MAX
+
+class PlacementEngine {
+    /*max segment tree with a search for the nearest index holding at least a given value*/
+    class MaxTree {
+        int size = 0;
+        std::vector<int> tree;
+    public:
+        void init(int n);
+        void set(int i, int value);
+        int max() const { return tree.empty() ? NO_COLUMN : tree[1]; }
+        int nextAtLeast(int from, int value) const;
+        int prevAtLeast(int from, int value) const;
+    };
+    struct Column {
+        std::vector<int> weights;
+        std::vector<int> stops;
+        std::vector<int> minStops; /*minStops[i] - the lowest stop at floors 0..i*/
+        bool excluded = false;
+    };
+    int dimX = 0, dimY = 0, dimZ = 0;
+    std::vector<Column> columns; /*index x * dimY + y*/
+    std::vector<MaxTree> rows;
+    MaxTree rowMaxima;
+    long long totalWeight = 0;
+    long long momentX = 0;
+    long long momentY = 0;
+
+    Column& column(int x, int y) { return columns[x * dimY + y]; }
+    const Column& column(int x, int y) const { return columns[x * dimY + y]; }
+    void update(int x, int y);
+    double offsetAfter(int x, int y, int kg) const;
+
+public:
+    void build(std::vector<std::vector<std::vector<Container>>>& shipMap, int z, int unknownStop);
+    void push(int x, int y, int kg, int stop);
+    void pop(int x, int y);
+    std::tuple<int,int> top(int x, int y) const;
+    void setExcluded(int x, int y, bool excluded);
+    bool findColumn(int kg, int stop, int& x, int& y) const;
+    int getStop(int x, int y) const;
+    int getHeight(int x, int y) const { return (int)column(x, y).weights.size(); }
+};
+
+#endif
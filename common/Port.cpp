@@ -9,13 +9,12 @@
  * @param command - (LOAD, UNLOAD, ARRIVED, PRIORITY)
  */
 void Port::addContainer(Container& container, Type command) {
-    switch(command){
-        case Type::LOAD: load.emplace_back(container); break;
-        case Type::UNLOAD: unload.emplace_back(container); break;
-        case Type::ARRIVED: arrived.emplace_back(container); break;
-        case Type::PRIORITY: priority.emplace_back(container); break;
-        default: std::cout << "Invalid command, please enter L/U/A/P." << std::endl;
+    ContainerQueue* queue = getQueue(command);
+    if(queue == nullptr){
+        std::cout << "Invalid command, please enter L/U/A/P." << std::endl;
+        return;
     }
+    queue->add(container);
 }
 
 const std::string&  Port::get_name() {
@@ -36,11 +35,7 @@ Port::~Port(){
     arrived.clear();
 }
 
-/**
- * gets all containers of the specified type
- * @param type - (LOAD, UNLOAD, ARRIVED, PRIORITY)
- */
-std::vector<Container>* Port::getContainerVec(Type type){
+ContainerQueue* Port::getQueue(Type type){
     switch(type){
         case Type::LOAD: return &this->load;
         case Type::UNLOAD: return &this->unload;
@@ -51,32 +46,135 @@ std::vector<Container>* Port::getContainerVec(Type type){
 }
 
 /**
- * removes container with equal id member
+ * gets all containers of the specified type
+ * @param type - (LOAD, UNLOAD, ARRIVED, PRIORITY)
+ */
+std::vector<Container>* Port::getContainerVec(Type type){
+    ContainerQueue* queue = getQueue(type);
+    return queue == nullptr ? nullptr : queue->data();
+}
+
+/**
+ * removes container with equal id member (the first one added if there are several)
  * @param id - id of container
  * @param command - (LOAD, UNLOAD, ARRIVED, PRIORITY)
  */
 void Port::removeContainer(std::string &id, Type command) {
-    int i = 0;
-    bool found = false;
-    if(command == Type::LOAD){
-        for(;i < (int)load.size(); i++){
-            if(load[i].getId() == id){
-                found = true;
-                break;
-            }
+    ContainerQueue* queue = getQueue(command);
+    if(queue != nullptr)
+        queue->remove(id);
+}
+
+/**
+ * finds container with equal id member
+ * @param id - id of container
+ * @param command - (LOAD, UNLOAD, ARRIVED, PRIORITY)
+ * @return the container, or nullptr if there's no such container
+ */
+Container* Port::findContainer(const std::string &id, Type command) {
+    ContainerQueue* queue = getQueue(command);
+    return queue == nullptr ? nullptr : queue->find(id);
+}
+
+/*----------------------ContainerQueue-------------------*/
+
+void ContainerQueue::add(const Container& container) {
+    items.emplace_back(container);
+    if(indexValid){
+        erased.push_back(false);
+        positions.emplace(items.back().getId(), items.size() - 1);
+    }
+}
+
+void ContainerQueue::rebuildIndex() {
+    compact();
+    erased.assign(items.size(), false);
+    positions.clear();
+    for(size_t i = 0; i < items.size(); i++)
+        positions.emplace(items[i].getId(), i);
+    indexValid = true;
+}
+
+/**
+ * removes the erased containers keeping the order of the rest, the index is invalidated
+ */
+void ContainerQueue::compact() {
+    if(numErased > 0){
+        size_t last = 0;
+        for(size_t i = 0; i < items.size(); i++){
+            if(erased[i]) continue;
+            if(last != i) items[last] = std::move(items[i]);
+            last++;
+        }
+        items.erase(items.begin() + last, items.end());
+        numErased = 0;
+    }
+    erased.clear();
+    positions.clear();
+    indexValid = false;
+}
+
+/**
+ * @return the position of the first (by order) container left with the given id, or -1
+ */
+long ContainerQueue::findPosition(const std::string& id) {
+    if(!indexValid) rebuildIndex();
+    long found = -1;
+    auto range = positions.equal_range(id);
+    for(auto it = range.first; it != range.second; ++it){
+        size_t pos = it->second;
+        /*the vector might been reordered by the caller of data() after the index was built*/
+        if(pos >= items.size() || items[pos].getId() != id){
+            rebuildIndex();
+            return findPosition(id);
         }
-        if(found)
-            load.erase(load.begin()+i);
+        if(!erased[pos] && (found == -1 || (long)pos < found))
+            found = (long)pos;
     }
-    else if(command == Type::PRIORITY){
-        for(; (int)priority.size(); i++){
-            if(priority[i].getId() == id){
-                found = true;
-                break;
-            }
+    return found;
+}
+
+bool ContainerQueue::remove(const std::string& id) {
+    long pos = findPosition(id);
+    if(pos == -1) return false;
+    auto range = positions.equal_range(id);
+    for(auto it = range.first; it != range.second; ++it){
+        if((long)it->second == pos){
+            positions.erase(it);
+            break;
         }
-        if(found)
-            priority.erase(priority.begin()+i);
     }
+    erased[pos] = true;
+    numErased++;
+    if(numErased * 2 > items.size())
+        rebuildIndex();
+    return true;
+}
+
+Container* ContainerQueue::find(const std::string& id) {
+    long pos = findPosition(id);
+    return pos == -1 ? nullptr : &items[pos];
+}
+
+/**
+ * @return the containers vector in insertion order, the caller may modify it so the index is rebuilt on next use
+ */
+std::vector<Container>* ContainerQueue::data() {
+    compact();
+    return &items;
+}
+
+/**
+ * @return the number of containers left (the erased ones aren't counted)
+ */
+size_t ContainerQueue::size() const {
+    return items.size() - numErased;
+}
 
+void ContainerQueue::clear() {
+    items.clear();
+    erased.clear();
+    positions.clear();
+    numErased = 0;
+    indexValid = true;
 }
@@ -15,6 +15,13 @@
 * get_name          - returns the name of the port.
 * operator==        - returns true if this->name == p->name.
 * getContainerVec   - returns pointer to the type vector(load, priority, unload or arrived) of port.
+* removeContainer   - removes the container with the given id from the type queue of port.
+* findContainer     - returns the container with the given id at the type queue of port, or nullptr.
+*
+* each type is kept in a ContainerQueue, an insertion ordered vector indexed by id:
+* removal marks the container as erased in O(1) and the erased ones are compacted out (keeping the order)
+* before the vector is handed out by getContainerVec, or once they are the majority.
+* the index is rebuilt lazily after the vector was handed out, as the caller may reorder it (e.g. sort).
 *
 */
 #ifndef PORT_HEADER
@@ -29,18 +36,40 @@
 #include <iterator>
 #include <vector>
 #include <stack>
+#include <unordered_map>
 class Ship; class Container;
 
 /*----------------------Prefix variables-------------------*/
 enum class Type {PRIORITY = 'P', LOAD = 'L', UNLOAD = 'U', ARRIVED = 'A'};
 
 
+class ContainerQueue {
+    std::vector<Container> items;
+    std::vector<bool> erased;
+    std::unordered_multimap<std::string,size_t> positions;
+    size_t numErased = 0;
+    bool indexValid = true;
+
+    void rebuildIndex();
+    void compact();
+    long findPosition(const std::string& id);
+public:
+    void add(const Container& container);
+    bool remove(const std::string& id);
+    Container* find(const std::string& id);
+    std::vector<Container>* data();
+    size_t size() const;
+    void clear();
+};
+
 class Port {
     std::string name;
-    std::vector<Container> priority;
-    std::vector<Container> load;
-    std::vector<Container> unload;
-    std::vector<Container> arrived;
+    ContainerQueue priority;
+    ContainerQueue load;
+    ContainerQueue unload;
+    ContainerQueue arrived;
+
+    ContainerQueue* getQueue(Type type);
 public:
     /*C'tor*/
 Port(const std::string& name) : name(name){}
@@ -48,6 +77,7 @@ Port(const std::string& name) : name(name){}
 
     void addContainer(Container& container,Type command);
     void removeContainer(std::string& id,Type command);
+    Container* findContainer(const std::string& id,Type command);
     const std::string & get_name();
     bool operator==(const Port& p);
     std::vector<Container>* getContainerVec(Type type);
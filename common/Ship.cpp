@@ -39,16 +39,19 @@ std::vector<std::shared_ptr<Port>> Ship::getRoute() {
 	return this->route;
 }
 
-void Ship::addContainer(Container& container, std::tuple<int,int> coordinate) {
+/**
+ * @param stop - the index in the route of the port the container is unloaded at (see getStop), only kept by the
+ * placement engine, 0 (leaves first) if unknown
+ */
+void Ship::addContainer(Container& container, std::tuple<int,int> coordinate, int stop) {
     //containers by port add
-    if(this->containersByPort.find(container.getDest()) == containersByPort.end()){
-        this->containersByPort.insert({container.getDest(), std::vector<Container>{container}});
-    } else {
-        this->containersByPort[container.getDest()].emplace_back(container);
-    }
+    this->containersByPort[container.getDest()].add(container);
+    idsOnShip.emplace(container.getId(), container.getDest());
     //ship map add
     shipMap[std::get<0>(coordinate)][std::get<1>(coordinate)].emplace_back(container);
     freeSpace--;
+    if(placementBuilt)
+        placement.push(std::get<0>(coordinate), std::get<1>(coordinate), container.getWeight(), stop);
 }
 
 std::vector<std::vector<std::vector<Container>>>& Ship::getMap() {
@@ -73,6 +76,7 @@ std::shared_ptr<Port> Ship::getPortByName(const std::string &name) {
 
 void Ship::setRoute(std::vector<std::shared_ptr<Port>>& route) {
     this->route = route;
+    this->indexStops();
     //init map of containers by port according to routes
     this->initContainersByPort(route);
 }
@@ -85,13 +89,12 @@ int Ship::getAxis(const std::string &str) const {
 }
 
 void Ship::getContainersToUnload(std::shared_ptr<Port>& pPort, std::vector<Container>** unload) {
-    *unload =  &containersByPort[pPort];
+    *unload = containersByPort[pPort].data();
 }
 
 void Ship::initContainersByPort(std::vector<std::shared_ptr<Port>>& vector) {
     for(auto& pPort : vector){
-        std::vector<Container> con;
-        this->containersByPort.insert({pPort, con});
+        this->containersByPort.insert({pPort, ContainerQueue()});
     }
 }
 
@@ -109,8 +112,14 @@ Ship::~Ship() {
 
 }
 
+/**
+ * the containers of containers_to_unload that already left the ship are skipped, the vector is handed out by
+ * getContainersToUnload before the unloads and removeContainer doesn't shrink it
+ */
 void Ship::getCoordinatesToHandle(std::set<coordinate> &coordinates_to_handle, std::vector<Container>& containers_to_unload) {
     for(Container& con : containers_to_unload){
+        if(!isOnShip(con))
+            continue;
         coordinates_to_handle.emplace(coordinate(std::get<0>(this->getCoordinate(con)),std::get<1>(this->getCoordinate(con))));
     }
 }
@@ -134,78 +143,183 @@ bool Ship::findColumnToMoveTo(coordinate old_coor, coordinate& new_coor,
         std::vector<Container>& containersToUnload, int weight, WeightBalanceCalculator& calc) {
     std::set<coordinate> coordinates_to_check;
     this->getCoordinatesToHandle(coordinates_to_check, containersToUnload);
-    int x = 0; int y = 0;
-    for(auto coor_x : shipMap){
-        for(auto coor_y : coor_x){
-            int size = this->shipMap[x][y].size();
-            int capacity = this->shipMap[x][y].capacity();
-            if(!std::count(coordinates_to_check.begin(), coordinates_to_check.end(), std::make_tuple(x,y)) &&
-                size < capacity &&
-                calc.tryOperation('U', weight, std::get<0>(old_coor), std::get<1>(old_coor)) == APPROVED &&
-                calc.tryOperation('L', weight, x, y) == APPROVED){
+    /*The unload is registered only if a column to load to is found*/
+    size_t checkpoint = calc.checkpoint();
+    if(calc.tryOperation('U', weight, std::get<0>(old_coor), std::get<1>(old_coor)) == APPROVED){
+        /*The columns approved for loading after the unload, computed once for all the candidates*/
+        BalanceMask approved = calc.approvedColumns('L', weight);
+        for(int x = 0; x < (int)shipMap.size(); x++){
+            for(int y = 0; y < (int)shipMap[x].size(); y++){
+                if(shipMap[x][y].size() < shipMap[x][y].capacity() && approved.test(x, y) &&
+                   coordinates_to_check.find(std::make_tuple(x,y)) == coordinates_to_check.end() &&
+                   calc.tryOperation('L', weight, x, y) == APPROVED){
                     new_coor = std::make_tuple(x,y);
+                    calc.commit(checkpoint);
                     return true;
+                }
             }
-            ++y;
         }
-        ++x;
-        y=0;
     }
+    calc.rollback(checkpoint);
     return false;
 }
 
 void Ship::moveContainer(coordinate origin, coordinate dest) {
     shipMap[std::get<0>(dest)][std::get<1>(dest)].emplace_back(shipMap[std::get<0>(origin)][std::get<1>(origin)].back());
     shipMap[std::get<0>(origin)][std::get<1>(origin)].pop_back();
+    firstOpenColumn = std::min(firstOpenColumn, std::get<0>(origin) * y + std::get<1>(origin));
+    if(placementBuilt){
+        auto [kg, stop] = placement.top(std::get<0>(origin), std::get<1>(origin));
+        placement.pop(std::get<0>(origin), std::get<1>(origin));
+        placement.push(std::get<0>(dest), std::get<1>(dest), kg, stop);
+    }
 }
 
 int Ship::getTopFloor(coordinate coor) {
     return shipMap[std::get<0>(coor)][std::get<1>(coor)].size();
 }
 
-void Ship::findColumnToLoad(coordinate &coor, bool &found, int kg, WeightBalanceCalculator& calc) {
-    int x = 0; int y = 0;
-    for(auto& coor_x : shipMap){
-        for(auto& coor_y : coor_x){
-            if(coor_y.empty()){}
-            int size = shipMap[x][y].size(); int capacity = shipMap[x][y].capacity();
-            if(size < capacity &&
-                    calc.tryOperation('L', kg, x, y) == APPROVED && !found){
-                coor = std::make_tuple(x,y);
-                found = true;
-                break;
-            }
-            ++y;
-        }
-        if(found){
-            break;
+void Ship::findColumnToLoad(coordinate &coor, bool &found, int kg, const WeightBalanceCalculator& calc) {
+    auto isFull = [this](int column){
+        auto& col = shipMap[column / y][column % y];
+        return col.size() >= col.capacity();
+    };
+    while(firstOpenColumn < x * y && isFull(firstOpenColumn))
+        firstOpenColumn++;
+    /*The columns approved for loading kg, computed once for the whole ship, nothing is registered at calc*/
+    BalanceMask approved = calc.approvedColumns('L', kg);
+    for(int column = firstOpenColumn; column < x * y && !found; column++){
+        int X = column / y, Y = column % y;
+        if(!isFull(column) && approved.test(X, Y)){
+            coor = std::make_tuple(X, Y);
+            found = true;
         }
-        ++x;
-        y = 0;
     }
 }
 
-std::map<std::shared_ptr<Port>,std::vector<Container>>& Ship::getContainersByPort() {
+/**
+ * builds the placement engine on first use, containers already on the ship (other than blocks) are given stop 0
+ */
+PlacementEngine& Ship::getPlacementEngine() {
+    if(!placementBuilt){
+        placement.build(shipMap, z, 0);
+        placementBuilt = true;
+    }
+    return placement;
+}
+
+/**
+ * indexes the visits of every port in the route by it's name, for getStop
+ */
+void Ship::indexStops() {
+    stopsByPort.clear();
+    for(int stop = 0; stop < (int)route.size(); stop++)
+        stopsByPort[route[stop]->get_name()].push_back(stop);
+}
+
+/**
+ * @return the index in the route of the first visit at dest after the currentStop, route size if there's none
+ */
+int Ship::getStop(std::shared_ptr<Port>& dest, int currentStop) {
+    auto visits = stopsByPort.find(dest->get_name());
+    if(visits == stopsByPort.end())
+        return (int)route.size();
+    auto next = std::upper_bound(visits->second.begin(), visits->second.end(), currentStop);
+    return next == visits->second.end() ? (int)route.size() : *next;
+}
+
+/**
+ * finds a column to load kg (unloaded at stop) to that keeps the ship balanced (PlacementEngine::findColumn),
+ * preferring the columns it's stacked in order on (no container under it leaves before it), nothing is registered
+ * at calc (as findColumnToLoad, the caller registers the load once it's made).
+ * if calc declines that column, the first approved column is taken (as findColumnToLoad).
+ * @return true iff a column was found
+ */
+bool Ship::findBalancedColumnToLoad(coordinate &coor, int kg, int stop, const WeightBalanceCalculator& calc) {
+    int X = 0, Y = 0;
+    if(getPlacementEngine().findColumn(kg, stop, X, Y) && calc.probe('L', kg, X, Y) == APPROVED){
+        coor = std::make_tuple(X, Y);
+        return true;
+    }
+    bool found = false;
+    findColumnToLoad(coor, found, kg, calc);
+    return found;
+}
+
+/**
+ * finds the column to move the top container of old_coor to, same as findBalancedColumnToLoad without the columns
+ * of containersToUnload and old_coor, the unload and the load are registered at calc only if a column was found.
+ * if calc declines the chosen column, the first approved column is taken (as findColumnToMoveTo).
+ * @return true iff a column was found
+ */
+bool Ship::findBalancedColumnToMoveTo(coordinate old_coor, coordinate& new_coor,
+        std::vector<Container>& containersToUnload, WeightBalanceCalculator& calc) {
+    PlacementEngine& engine = getPlacementEngine();
+    int oldX = std::get<0>(old_coor), oldY = std::get<1>(old_coor);
+    auto [kg, stop] = engine.top(oldX, oldY);
+    std::set<coordinate> coordinates_to_check;
+    this->getCoordinatesToHandle(coordinates_to_check, containersToUnload);
+    coordinates_to_check.insert(old_coor);
+    /*The search is over the ship after the unload, without the excluded columns*/
+    engine.pop(oldX, oldY);
+    for(auto& coor : coordinates_to_check)
+        engine.setExcluded(std::get<0>(coor), std::get<1>(coor), true);
+    int X = 0, Y = 0;
+    bool found = engine.findColumn(kg, stop, X, Y);
+    for(auto& coor : coordinates_to_check)
+        engine.setExcluded(std::get<0>(coor), std::get<1>(coor), false);
+    engine.push(oldX, oldY, kg, stop);
+
+    if(!found)
+        return false;
+    size_t checkpoint = calc.checkpoint();
+    if(calc.tryOperation('U', kg, oldX, oldY) == APPROVED && calc.tryOperation('L', kg, X, Y) == APPROVED){
+        new_coor = std::make_tuple(X, Y);
+        calc.commit(checkpoint);
+        return true;
+    }
+    calc.rollback(checkpoint);
+    return findColumnToMoveTo(old_coor, new_coor, containersToUnload, kg, calc);
+}
+
+std::map<std::shared_ptr<Port>,ContainerQueue>& Ship::getContainersByPort() {
     return this->containersByPort;
 }
 
 void Ship::removeContainer(coordinate coor) {
     Container* con = &shipMap[std::get<0>(coor)][std::get<1>(coor)].back();
-    containersByPort[con->getDest()].erase(std::find(containersByPort[con->getDest()].begin(), containersByPort[con->getDest()].end(), *con));
+    containersByPort[con->getDest()].remove(con->getId());
+    auto range = idsOnShip.equal_range(con->getId());
+    for(auto it = range.first; it != range.second; ++it){
+        if(it->second == con->getDest()){
+            idsOnShip.erase(it);
+            break;
+        }
+    }
     shipMap[std::get<0>(coor)][std::get<1>(coor)].pop_back();
+    firstOpenColumn = std::min(firstOpenColumn, std::get<0>(coor) * y + std::get<1>(coor));
     freeSpace++;
+    if(placementBuilt)
+        placement.pop(std::get<0>(coor), std::get<1>(coor));
 }
 
 int Ship::getFreeSpace() const {
     return freeSpace;
 }
 
+/**
+ * @return true iff a container with con's id and destination is on the ship, by the id index (O(1))
+ */
 bool Ship::isOnShip(Container &con) {
-    if ( containersByPort.find(con.getDest()) == containersByPort.end() ) {
-        return false;
-    } else {
-        auto pos = std::find(containersByPort[con.getDest()].begin(),containersByPort[con.getDest()].end(), con);
-        return pos != containersByPort[con.getDest()].end();
+    auto range = idsOnShip.equal_range(con.getId());
+    for(auto it = range.first; it != range.second; ++it){
+        if(it->second == con.getDest())
+            return true;
     }
+    return false;
+}
+
+bool Ship::isIdOnShip(const std::string& id) const {
+    return idsOnShip.find(id) != idsOnShip.end();
 }
 
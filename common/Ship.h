@@ -4,6 +4,16 @@
 /**
 * This header is a container of a ship that holds 3D vector of containers
 * and the route of the current ship
+* -placement: the ship keeps a PlacementEngine (built on first use, after the plan's blocks were set) that indexes the
+*  columns' heights, stops and the center of mass, findBalancedColumnToLoad/findBalancedColumnToMoveTo use it to choose
+*  a column that keeps the ship balanced in logarithmic time (see PlacementEngine::findColumn), and fall back to the
+*  first approved column if the calculator declines it. it's kept updated by addContainer/removeContainer/moveContainer.
+* -stops: the route's visits are indexed by port name (setRoute), so getStop is a lookup instead of a route scan.
+* -containers by port: the containers on the ship are kept by their destination in a ContainerQueue (see Port.h),
+*  so removeContainer erases a container in O(1) instead of a search of it's destination's vector.
+* -first fit: findColumnToLoad skips the columns that are known to be full (removeContainer/moveContainer open them
+*  again), so filling the ship column by column is amortized O(1) per container instead of a scan of the whole ship.
+*  it only searches the calculator's approved columns, the caller registers the load once it's made.
 *
 */
 class Container; class Port;
@@ -14,6 +24,7 @@ class Container; class Port;
 #include <list>
 #include <iterator>
 #include <map>
+#include <unordered_map>
 #include "Port.h"
 #include "Container.h"
 #include <stack>
@@ -21,16 +32,22 @@ class Container; class Port;
 #include <algorithm>
 #include <memory>
 #include "../interfaces/WeightBalanceCalculator.h"
+#include "PlacementEngine.h"
 
 typedef std::tuple<int,int> coordinate;
 const char delim[] = {',','\t','\r',' ','\n','\0'};
 
 class Ship {
     std::vector<std::vector<std::vector<Container>>> shipMap;
-    std::map<std::shared_ptr<Port>, std::vector<Container>> containersByPort;
+    std::map<std::shared_ptr<Port>, ContainerQueue> containersByPort;
+    std::unordered_multimap<std::string, std::shared_ptr<Port>> idsOnShip; /*id --> destination, of every container at containersByPort*/
     std::vector<std::shared_ptr<Port>> route;
+    std::unordered_map<std::string, std::vector<int>> stopsByPort; /*port name --> it's indexes in route, ascending*/
     int freeSpace;
     int x, y, z;
+    PlacementEngine placement;
+    bool placementBuilt = false;
+    int firstOpenColumn = 0; /*every column before it (by x * y + y) is full, findColumnToLoad starts from it*/
 public:
     /*given a route of ports, the C'tor parses the containers of any port to a map*/
     Ship(int x, int y, int z) {
@@ -81,6 +98,7 @@ public:
             }
             found = false;
         }
+        indexStops();
     }
     ~Ship();
     std::tuple<int, int, int> getCoordinate(const Container& container);
@@ -88,9 +106,10 @@ public:
     std::vector<std::shared_ptr<Port>> getRoute();
     std::vector<std::vector<std::vector<Container>>>& getMap();
     std::shared_ptr<Port> getPortByName(const std::string &name);
-    std::map<std::shared_ptr<Port>,std::vector<Container>>& getContainersByPort();
+    std::map<std::shared_ptr<Port>,ContainerQueue>& getContainersByPort();
     void initContainersByPort(std::vector<std::shared_ptr<Port>>& vector);
     void setRoute(std::vector<std::shared_ptr<Port>>& route);
+    void indexStops();
     int getAxis(const std::string& str) const;
     void getCoordinatesToHandle(std::set<coordinate> &coordinates_to_handle, std::vector<Container>& containers_to_unload);
     int getLowestFloorOfRelevantContainer(std::shared_ptr<Port>& pPort, coordinate coor);
@@ -99,12 +118,17 @@ public:
     int getFreeSpace() const;
     void getContainersToUnload(std::shared_ptr<Port>& port, std::vector<Container>** unload);
     bool findColumnToMoveTo(coordinate old_coor, coordinate& new_coor, std::vector<Container>& containersToUnload, int weight, WeightBalanceCalculator& calc);
-    void findColumnToLoad(coordinate &coor, bool &found, int kg, WeightBalanceCalculator& calc);
-    void addContainer(Container& container, std::tuple<int,int> coordinate);
+    void findColumnToLoad(coordinate &coor, bool &found, int kg, const WeightBalanceCalculator& calc);
+    bool findBalancedColumnToLoad(coordinate &coor, int kg, int stop, const WeightBalanceCalculator& calc);
+    bool findBalancedColumnToMoveTo(coordinate old_coor, coordinate& new_coor, std::vector<Container>& containersToUnload, WeightBalanceCalculator& calc);
+    PlacementEngine& getPlacementEngine();
+    int getStop(std::shared_ptr<Port>& dest, int currentStop);
+    void addContainer(Container& container, std::tuple<int,int> coordinate, int stop = 0);
     void removeContainer(coordinate coor);
     void moveContainer(coordinate origin, coordinate dest);
     void updateFreeSpace(int num);
     bool isOnShip(Container &con);
+    bool isIdOnShip(const std::string& id) const;
 
 };
 
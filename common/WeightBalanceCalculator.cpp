@@ -1,72 +1,210 @@
 #include "../interfaces/WeightBalanceCalculator.h"
 #include "Parser.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * checks a single axis: declined iff the operation moves the center of mass away from the ship center and the
+ * center of mass ends more than maxOffset columns away from it
+ */
+bool WeightBalanceCalculator::isImbalanced(long long moment, long long newMoment, long long newTotal, double maxOffset) {
+    if(maxOffset < 0 || newTotal <= 0)
+        return false;
+    return std::llabs(newMoment) > std::llabs(moment) && (double)std::llabs(newMoment) > 2 * maxOffset * (double)newTotal;
+}
 
 BalanceStatus WeightBalanceCalculator::tryOperation(char loadUnload, int kg, int X, int Y) {
-    std::tuple<bool, bool> x_y_imbalance;
-//    std::vector<Container>& column = (this->shipMap).at(X).at(Y);
-    switch(loadUnload){
-        case 'L':
-            if(kg > 0 && X >= 0 && Y >= 0){
-                return APPROVED;
-            }
-            break;
-//            checkLoad(x_y_imbalance, kg, column);
-//            break;
-        case 'U':
-            return APPROVED;
-//            checkUnload(x_y_imbalance, kg, column);
-//            break;
-        default:
-            return FAILED;
-    }
+    BalanceStatus status = probe(loadUnload, kg, X, Y);
+    /*Approved --> registered as done*/
+    if(status == APPROVED && !columnWeights.empty())
+        registerOperation(X, Y, loadUnload == 'L' ? kg : -(long long)kg);
+    return status;
+}
 
-    if(std::get<0>(x_y_imbalance) && std::get<1>(x_y_imbalance)){
+/**
+ * @return the answer of tryOperation(loadUnload, kg, X, Y), nothing is registered
+ */
+BalanceStatus WeightBalanceCalculator::probe(char loadUnload, int kg, int X, int Y) const {
+    if(loadUnload != 'L' && loadUnload != 'U')
+        return FAILED;
+    /*Case the plan wasn't read --> nothing to balance*/
+    if(columnWeights.empty())
+        return APPROVED;
+    if(X < 0 || X >= dimX || Y < 0 || Y >= dimY)
+        return FAILED;
+    long long delta = loadUnload == 'L' ? kg : -(long long)kg;
+    long long newTotal = totalWeight + delta;
+    bool xImbalanced = isImbalanced(momentX, momentX + delta * (2 * X - (dimX - 1)), newTotal, maxOffsetX);
+    bool yImbalanced = isImbalanced(momentY, momentY + delta * (2 * Y - (dimY - 1)), newTotal, maxOffsetY);
+    if(xImbalanced && yImbalanced)
         return X_Y_IMBALANCED;
-    }
-    else if(std::get<0>(x_y_imbalance) && !std::get<1>(x_y_imbalance)){
+    else if(xImbalanced)
         return X_IMBALANCED;
-    } else if(!std::get<0>(x_y_imbalance) && std::get<1>(x_y_imbalance)){
+    else if(yImbalanced)
         return Y_IMBALANCED;
-    } else {
-        //ex3
-//        switch(loadUnload){
-//            case 'L': {
-//                std::unique_ptr<Container> con = std::make_unique<Container>(kg);
-//                column.emplace_back(*con);
-//                break;
-//            }
-//            case 'U': {
-//                column.pop_back();
-//                break;
-//            }
-//        }
-        return APPROVED;
+    return APPROVED;
+}
+
+/**
+ * adds delta kg at column (X,Y), kept at the undo log while a checkpoint is open
+ */
+void WeightBalanceCalculator::registerOperation(int X, int Y, long long delta) {
+    columnWeights[X * dimY + Y] += delta;
+    totalWeight += delta;
+    momentX += delta * (2 * X - (dimX - 1));
+    momentY += delta * (2 * Y - (dimY - 1));
+    if(openCheckpoints > 0)
+        undoLog.push_back({X, Y, delta});
+}
+
+/**
+ * opens a checkpoint
+ * @return the checkpoint, to be given to rollback or commit
+ */
+size_t WeightBalanceCalculator::checkpoint() {
+    openCheckpoints++;
+    return undoLog.size();
+}
+
+/**
+ * undoes the operations registered since the given checkpoint and closes it
+ */
+void WeightBalanceCalculator::rollback(size_t checkpoint) {
+    while(undoLog.size() > checkpoint){
+        Registered last = undoLog.back();
+        undoLog.pop_back();
+        columnWeights[last.X * dimY + last.Y] -= last.delta;
+        totalWeight -= last.delta;
+        momentX -= last.delta * (2 * last.X - (dimX - 1));
+        momentY -= last.delta * (2 * last.Y - (dimY - 1));
+    }
+    commit(checkpoint);
+}
+
+/**
+ * keeps the operations registered since the given checkpoint and closes it
+ */
+void WeightBalanceCalculator::commit(size_t checkpoint) {
+    if(undoLog.size() < checkpoint || openCheckpoints == 0)
+        return;
+    /*Case there's an outer checkpoint --> it may still roll these operations back*/
+    if(--openCheckpoints == 0)
+        undoLog.clear();
+}
+
+/**
+ * @return the columns tryOperation(loadUnload, kg, X, Y) would approve, nothing is registered.
+ * computed per axis over the moment each coordinate adds, O(X + Y)
+ */
+BalanceMask WeightBalanceCalculator::approvedColumns(char loadUnload, int kg) const {
+    BalanceMask mask;
+    if(loadUnload != 'L' && loadUnload != 'U')
+        return mask;
+    if(columnWeights.empty()){
+        mask.approveAll = true;
+        return mask;
+    }
+    long long delta = loadUnload == 'L' ? kg : -(long long)kg;
+    long long newTotal = totalWeight + delta;
+    mask.xApproved.resize(dimX);
+    mask.yApproved.resize(dimY);
+    for(int x = 0; x < dimX; x++)
+        mask.xApproved[x] = !isImbalanced(momentX, momentX + delta * (2 * x - (dimX - 1)), newTotal, maxOffsetX);
+    for(int y = 0; y < dimY; y++)
+        mask.yApproved[y] = !isImbalanced(momentY, momentY + delta * (2 * y - (dimY - 1)), newTotal, maxOffsetY);
+    return mask;
+}
+
+/**
+ * @return the interval [first, last] of the coordinates of an axis of size dim that adding delta at is approved
+ * (first > last if there's none). the moment added is linear in the coordinate, so the approved coordinates are the
+ * ones around the coordinate that brings the moment closest to zero, their edges are found by binary search.
+ */
+std::pair<int,int> WeightBalanceCalculator::approvedInterval(long long moment, long long delta, long long newTotal, double maxOffset, int dim) {
+    auto approved = [=](int c){ return !isImbalanced(moment, moment + delta * (2 * c - (dim - 1)), newTotal, maxOffset); };
+    auto distance = [=](int c){ return std::llabs(moment + delta * (2 * c - (dim - 1))); };
+    if(dim <= 0)
+        return {0, -1};
+    int center = 0;
+    if(delta != 0){
+        double zero = ((double)(dim - 1) - (double)moment / (double)delta) / 2;
+        center = (int)std::clamp(std::llround(zero), 0LL, (long long)dim - 1);
+        /*rounding may miss the closest coordinate by one*/
+        for(int c : {center - 1, center + 1})
+            if(c >= 0 && c < dim && distance(c) < distance(center))
+                center = c;
+    }
+    if(!approved(center))
+        return {0, -1};
+    int lo = 0, hi = center; /*first approved at [lo, hi]*/
+    while(lo < hi){
+        int mid = (lo + hi) / 2;
+        if(approved(mid)) hi = mid; else lo = mid + 1;
+    }
+    int first = lo;
+    lo = center, hi = dim - 1; /*last approved at [lo, hi]*/
+    while(lo < hi){
+        int mid = (lo + hi + 1) / 2;
+        if(approved(mid)) lo = mid; else hi = mid - 1;
     }
+    return {first, lo};
 }
-// ex. 3
-//void WeightBalanceCalculator::checkLoad(std::tuple<bool, bool> &x_y_imbalance, int kg, std::vector<Container> &column) {
-//    if(1) return;
-//    if(kg >= 0 && !column.empty()){
-//        x_y_imbalance = std::pair(false, false);
-//    }
-//
-//}
-//
-//void WeightBalanceCalculator::checkUnload(std::tuple<bool, bool> &x_y_imbalance, int kg, std::vector<Container> &column) {
-//    if(1)return;
-//    if(kg >= 0 && !column.empty()){ //dummy use
-//        x_y_imbalance = std::pair(false, false);
-//    }
-//}
 
+/**
+ * @return the columns tryOperation(loadUnload, kg, X, Y) would approve as an interval per axis, nothing is registered.
+ * same as approvedColumns, O(log X + log Y)
+ */
+BalanceRange WeightBalanceCalculator::approvedRange(char loadUnload, int kg) const {
+    BalanceRange range;
+    if(loadUnload != 'L' && loadUnload != 'U')
+        return range;
+    if(columnWeights.empty()){
+        range.approveAll = true;
+        return range;
+    }
+    long long delta = loadUnload == 'L' ? kg : -(long long)kg;
+    long long newTotal = totalWeight + delta;
+    std::tie(range.firstX, range.lastX) = approvedInterval(momentX, delta, newTotal, maxOffsetX, dimX);
+    std::tie(range.firstY, range.lastY) = approvedInterval(momentY, delta, newTotal, maxOffsetY, dimY);
+    return range;
+}
+
+/**
+ * reads the ship dimensions from the plan file and resets the registered cargo
+ */
 int WeightBalanceCalculator::readShipPlan(const std::string &full_path_and_file_name) {
-//    ex. 3
-//    std::unique_ptr<Ship> ship;
-//    int val = extractShipPlan(full_path_and_file_name, ship) + extractArgsForBlocks(ship, full_path_and_file_name);
-//    this->shipMap = std::move(*ship->getMap());
-//    return val;
     if(full_path_and_file_name.empty()){
         return -1;
     }
+    std::array<int,3> dimensions{};
+    std::ifstream inFile(full_path_and_file_name);
+    columnWeights.clear();
+    undoLog.clear();
+    openCheckpoints = 0;
+    totalWeight = momentX = momentY = 0;
+    dimX = dimY = 0;
+    if(inFile.fail())
+        return 0;
+    getDimensions(dimensions, inFile, "byFile");
+    if(dimensions[0] < 0 || dimensions[1] <= 0 || dimensions[2] <= 0)
+        return 0;
+    dimX = dimensions[1];
+    dimY = dimensions[2];
+    columnWeights.assign((size_t)dimX * dimY, 0);
     return 0;
 }
+
+/**
+ * sets the max distance (in columns) of the center of mass from the ship center on each axis,
+ * NO_BALANCE_LIMIT (or any negative value) --> the axis is not checked
+ */
+void WeightBalanceCalculator::setImbalanceThresholds(double maxX, double maxY) {
+    maxOffsetX = maxX;
+    maxOffsetY = maxY;
+}
+
+long long WeightBalanceCalculator::getColumnWeight(int X, int Y) const {
+    if(X < 0 || X >= dimX || Y < 0 || Y >= dimY)
+        return 0;
+    return columnWeights[X * dimY + Y];
+}
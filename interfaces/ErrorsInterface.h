@@ -38,6 +38,7 @@
 
 /*----------------------Validation Errors-------------------*/
 #define ERROR_CONT_LINE_INSTRUCTION(x,y,z,w)    "Error: algorithm instructed invalid instruction at port " + x + " visit number " + toString(z) + " instruction: " + w + " container id " + y
+#define ERROR_BAD_INSTRUCTION_LINE(x,y,z)       "Error: algorithm wrote malformed crane instruction line: " + x + " at port " + y + " visit number " + toString(z)
 #define ERROR_PLAN_FATAL                        "Error: algorithm indicated there's a fatal error in plan file --> simulator rejects"
 #define ERROR_DUPLICATE_XY                      "Error: algorithm indicated there's a to (x,y) constraints with different Z value --> simulator rejects"
 #define ERROR_TRAVEL_FATAL                      "Error: algorithm indicates there's a fatal error in route file --> simulator rejects"
@@ -49,12 +50,15 @@
 #define ERROR_CONT_LEFT_ONPORT(x,y,z)           "Error: container " + x + " left at port " + y + " while ship has space"
 #define ERROR_LEFT_PRIORITY_ONPORT              "Error: There is at least 1 prioritized container that left on port but supposed to be loaded"
 #define ERROR_CONT_LEFT_LAST_PORT(x)            "Error: container " + x + " left on ship at the end of the travel"
+#define ERROR_SUPPRESSED(x,y)                   "Error: " + toString(x) + " more errors like this one were not recorded: " + y
 
 /*----------------------Simulator Errors-------------------*/
 #define ERROR_NOT_DIRECTORY(x,y)                "Error: " + x.path().filename().string() + y
 #define ERROR_TRAVEL_NAME(x)                    "Error: " + x + " is not a valid travel name,ignoring"
 #define ERROR_INVALID_FILE(x)                   "Error: " + x + " is not a valid route/port/ship plan file, ignoring"
 #define P_ALGNOTREGISTER(x)                     std::cerr << "Error: algorithm: " + x + " didn't register, ignoring this algorithm" << std::endl;
+#define P_INVALID_SAMPLED_POLICY(x)             std::cerr << "Error: " + x + " is not a valid sampled validation policy, ignoring" << std::endl;
+#define P_INVALID_BALANCE_THRESHOLD(x)          std::cerr << "Error: " + x + " is not a valid balance threshold, ignoring" << std::endl;
 #define ERROR_ALG_PLAN                          "Error: Algorithm crashed in read plan/route or calculator initialize"
 #define ERROR_ALG_FAILED                        "Error: Algorithm Failed in get instructions for cargo"
 
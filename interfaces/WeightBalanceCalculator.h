@@ -2,6 +2,8 @@
 #define SHIP1_WEIGHTBALANCECALCULATOR_H
 
 #include <string>
+#include <vector>
+#include <utility>
 
 /**
  * The calculator shall be initiated by the simulation with the ship plan file:
@@ -26,15 +28,87 @@ It shall have the following methods:
 
 enum BalanceStatus {APPROVED, X_IMBALANCED, Y_IMBALANCED, X_Y_IMBALANCED, FAILED};
 
+#define NO_BALANCE_LIMIT -1.0
+
+/**
+ * The set of columns the calculator approves for an operation of a given weight (see approvedColumns).
+ * the balance on each axis depends only on the column's coordinate on that axis, so it's kept as a mask per axis
+ * and a column is approved iff both it's x and it's y are approved.
+ */
+class BalanceMask {
+    friend class WeightBalanceCalculator;
+    std::vector<unsigned char> xApproved;
+    std::vector<unsigned char> yApproved;
+    bool approveAll = false;
+public:
+    bool test(int X, int Y) const {
+        if(approveAll)
+            return true;
+        return X >= 0 && X < (int)xApproved.size() && Y >= 0 && Y < (int)yApproved.size() && xApproved[X] && yApproved[Y];
+    }
+};
+
+/**
+ * The columns the calculator approves for an operation of a given weight as a rectangle (see approvedRange).
+ * on each axis the moment a coordinate adds is linear in it and an axis is approved iff the resulting moment is
+ * small enough, so the approved coordinates of an axis are a single interval [first, last] (empty if first > last).
+ */
+struct BalanceRange {
+    bool approveAll = false;
+    int firstX = 0, lastX = -1;
+    int firstY = 0, lastY = -1;
+    bool empty() const { return !approveAll && (firstX > lastX || firstY > lastY); }
+};
+
+/**
+ * Implementation notes:
+ *  the plan is parsed once by readShipPlan (only the ship dimensions matter for balance, blocks weigh nothing).
+ *  the weight of every column and the X and Y moments of the ship (sum of kg * distance of the column from the
+ *  ship center) are updated on every approved operation, so tryOperation is O(1).
+ *  an operation is declined on an axis if it moves the center of mass further away from the ship center on that axis
+ *  and the result is more than the axis threshold (in columns) away from it, operations that improve the balance
+ *  are always approved. the thresholds are NO_BALANCE_LIMIT (approve everything) unless set by setImbalanceThresholds.
+ *  if the plan couldn't be read every operation is approved and nothing is registered.
+ *  approvedColumns answers tryOperation for all the columns at once, without registering anything.
+ *  probe answers tryOperation for a single column without registering it.
+ *  approvedRange answers the same as approvedColumns as an interval per axis, in O(log X + log Y).
+ *  checkpoint/rollback: while a checkpoint is open the registered operations are kept at an undo log,
+ *  rollback undoes the operations registered since the checkpoint, commit keeps them (both close the checkpoint).
+ *  checkpoints may be nested, they must be closed in reverse order.
+ */
 class WeightBalanceCalculator {
-    //ex.3
-//    std::vector<std::vector<std::vector<Container>>> shipMap;
+    int dimX = 0;
+    int dimY = 0;
+    std::vector<long long> columnWeights; /*index x * dimY + y*/
+    long long totalWeight = 0;
+    /*moments relative to the ship center, kg * (2x - (dimX - 1)) so they stay integral*/
+    long long momentX = 0;
+    long long momentY = 0;
+    double maxOffsetX = NO_BALANCE_LIMIT;
+    double maxOffsetY = NO_BALANCE_LIMIT;
+    struct Registered {
+        int X;
+        int Y;
+        long long delta;
+    };
+    std::vector<Registered> undoLog;
+    int openCheckpoints = 0;
+
+    static bool isImbalanced(long long moment, long long newMoment, long long newTotal, double maxOffset);
+    static std::pair<int,int> approvedInterval(long long moment, long long delta, long long newTotal, double maxOffset, int dim);
+    void registerOperation(int X, int Y, long long delta);
+
 public:
     int readShipPlan(const std::string& full_path_and_file_name);
     BalanceStatus  tryOperation(char loadUnload, int kg, int X, int Y);
-    //ex.3
-//    void checkLoad(std::tuple<bool, bool> &x_y_imbalance, int kg, std::vector<Container> &column);
-//    void checkUnload(std::tuple<bool, bool> &x_y_imbalance, int kg, std::vector<Container> &column);
+    BalanceStatus  probe(char loadUnload, int kg, int X, int Y) const;
+    BalanceMask approvedColumns(char loadUnload, int kg) const;
+    BalanceRange approvedRange(char loadUnload, int kg) const;
+    size_t checkpoint();
+    void rollback(size_t checkpoint);
+    void commit(size_t checkpoint);
+    void setImbalanceThresholds(double maxOffsetX, double maxOffsetY);
+    long long getColumnWeight(int X, int Y) const;
 };
 
 #endif
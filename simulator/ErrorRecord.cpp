@@ -0,0 +1,61 @@
+#include "ErrorRecord.h"
+
+/**
+ * @return the message of the record, same as building it eagerly by the code's macro
+ */
+std::string ErrorRecord::format() const {
+    switch(code){
+        case ErrorCode::ContLineInstruction: return ERROR_CONT_LINE_INSTRUCTION(x, y, number, action);
+        case ErrorCode::BadInstructionLine: return ERROR_BAD_INSTRUCTION_LINE(x, y, number);
+        case ErrorCode::PlanFatal: return ERROR_PLAN_FATAL;
+        case ErrorCode::DuplicateXY: return ERROR_DUPLICATE_XY;
+        case ErrorCode::TravelFatal: return ERROR_TRAVEL_FATAL;
+        case ErrorCode::TravelSinglePort: return ERROR_TRAVEL_SINGLEPORT;
+        case ErrorCode::NoCargoToLoad: return ERROR_NO_CARGO_TOLOAD(x, number);
+        case ErrorCode::LineNotHandle: return ERROR_LINE_NOT_HANDLE(x, y, number);
+        case ErrorCode::ContNotInDest: return ERROR_CONT_NOT_INDEST(x, y, z);
+        case ErrorCode::ContLeftOnShip: return ERROR_CONT_LEFT_ONSHIP(x);
+        case ErrorCode::ContLeftOnPort: return ERROR_CONT_LEFT_ONPORT(x, y, z);
+        case ErrorCode::LeftPriorityOnPort: return ERROR_LEFT_PRIORITY_ONPORT;
+        case ErrorCode::ContLeftLastPort: return ERROR_CONT_LEFT_LAST_PORT(x);
+        case ErrorCode::AlgPlan: return ERROR_ALG_PLAN;
+        case ErrorCode::AlgFailed: return ERROR_ALG_FAILED;
+        default: return std::string();
+    }
+}
+
+/**
+ * counts the record, it's kept only if it's code didn't reach the cap yet
+ */
+void ErrorList::add(ErrorRecord record) {
+    size_t &counter = counters[(size_t)record.code];
+    if(capPerCode == 0 || counter < capPerCode)
+        records.emplace_back(std::move(record));
+    counter++;
+}
+
+void ErrorList::add(ErrorCode code, std::string x, std::string y, std::string z, int number, char action) {
+    add(ErrorRecord{code, action, number, std::move(x), std::move(y), std::move(z)});
+}
+
+void ErrorList::setCount(ErrorCode code, size_t count) {
+    counters[(size_t)code] = count;
+}
+
+/**
+ * runs func over the message of every kept record by the order they were added, then for every code that
+ * reached the cap, over a summary line with the number of it's errors that weren't kept
+ */
+void ErrorList::forEachMessage(const std::function<void(const std::string&)>& func) const {
+    std::array<size_t,NUM_OF_ERROR_CODES> kept{};
+    std::array<const ErrorRecord*,NUM_OF_ERROR_CODES> lastKept{};
+    for(auto &record : records){
+        func(record.format());
+        kept[(size_t)record.code]++;
+        lastKept[(size_t)record.code] = &record;
+    }
+    for(size_t code = 0; code < NUM_OF_ERROR_CODES; code++){
+        if(counters[code] > kept[code] && lastKept[code] != nullptr)
+            func(ERROR_SUPPRESSED(counters[code] - kept[code], lastKept[code]->format()));
+    }
+}
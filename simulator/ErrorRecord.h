@@ -0,0 +1,77 @@
+#ifndef ERROR_RECORD_H
+#define ERROR_RECORD_H
+/**
+* This header is a compact representation of the errors the simulator finds in an algorithm run.
+* an error is kept as a record (the error code and the parameters of it's message) and is formatted
+* to it's message (by the macros at ErrorsInterface.h) only when the errors file is written.
+* ErrorList keeps the records of a single algorithm run at a travel with a counter per error code,
+* if it has a cap, only the first cap errors of each code are kept, the rest are only counted and
+* a summary line is written instead of them.
+*
+*      *******      Functions      *******
+* ErrorRecord::format   - returns the message of the record
+* ErrorList::add        - adds an error record (or only counts it, if it's code reached the cap)
+* ErrorList::empty      - returns true iff no error was added
+* ErrorList::count      - returns the number of errors added with the given code (kept or not)
+* ErrorList::contains   - returns true iff an error with the given code was added
+* ErrorList::setCount   - sets the counter of an error code, used when restoring a list
+* ErrorList::forEachMessage - runs a given function over the messages of the kept records and the summary lines
+ */
+
+#include <string>
+#include <vector>
+#include <array>
+#include <functional>
+#include <cstdint>
+#include "../interfaces/ErrorsInterface.h"
+
+enum class ErrorCode : uint8_t {
+    ContLineInstruction,    /*x=port, y=container id, number=visit, action=instruction*/
+    BadInstructionLine,     /*x=line, y=port, number=visit*/
+    PlanFatal,
+    DuplicateXY,
+    TravelFatal,
+    TravelSinglePort,
+    NoCargoToLoad,          /*x=port, number=visit*/
+    LineNotHandle,          /*x=line, y=port, number=visit*/
+    ContNotInDest,          /*x=container id, y=port, z=destination*/
+    ContLeftOnShip,         /*x=container id*/
+    ContLeftOnPort,         /*x=container id, y=port, z=destination*/
+    LeftPriorityOnPort,
+    ContLeftLastPort,       /*x=container id*/
+    AlgPlan,
+    AlgFailed,
+    NumOfCodes
+};
+
+#define NUM_OF_ERROR_CODES (size_t)ErrorCode::NumOfCodes
+
+struct ErrorRecord {
+    ErrorCode code;
+    char action = 0;
+    int number = 0;
+    std::string x, y, z; /*the string parameters of the code's message, by their order at the message macro*/
+
+    std::string format() const;
+};
+
+class ErrorList {
+    std::vector<ErrorRecord> records;
+    std::array<size_t,NUM_OF_ERROR_CODES> counters{};
+    size_t capPerCode; /*0 --> no cap*/
+
+public:
+    explicit ErrorList(size_t capPerCode = 0):capPerCode(capPerCode){};
+    void add(ErrorRecord record);
+    void add(ErrorCode code, std::string x = std::string(), std::string y = std::string(),
+             std::string z = std::string(), int number = 0, char action = 0);
+    bool empty() const { return records.empty(); }
+    size_t count(ErrorCode code) const { return counters[(size_t)code]; }
+    bool contains(ErrorCode code) const { return count(code) > 0; }
+    void setCount(ErrorCode code, size_t count);
+    size_t getCap() const { return capPerCode; }
+    const std::vector<ErrorRecord>& getRecords() const { return records; }
+    void forEachMessage(const std::function<void(const std::string&)>& func) const;
+};
+
+#endif
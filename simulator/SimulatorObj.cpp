@@ -1,5 +1,11 @@
 #include "SimulatorObj.h"
 
+/**
+ * worker simulator, used to replay a single (travel, algorithm) pair, it doesn't list any travel
+ */
+SimulatorObj::SimulatorObj(const SimulatorObj* parent): simCalc(parent->simCalc), balanceThresholds(parent->balanceThresholds), mainOutputPath(parent->mainOutputPath),
+    mainTravelPath(parent->mainTravelPath), errorsCapPerCode(parent->errorsCapPerCode){}
+
 /**
  * This function sets the ship map of the simulator and the calculator ship map
  */
@@ -38,6 +44,9 @@ void SimulatorObj::compareRoutePortsVsCargoDataPorts(std::unique_ptr<Ship> &ship
 
 /**
  * This function initialize the list of travels from given -travel_path path
+ * the main folder is listed serially so travels keep the directory order, then every travel folder is scanned
+ * and it's plan and route are parsed concurrently, each travel writes only to it's own errors.
+ * at streaming mode only the travel folders are listed, travels are built lazily by forEachTravel.
  */
 void SimulatorObj::initListOfTravels(string &path){
     string msg = " only sub folders allowed in main folder, file won't be included in the program";
@@ -51,34 +60,246 @@ void SimulatorObj::initListOfTravels(string &path){
             this->generalErrors.emplace_back(ERROR_TRAVEL_NAME(travelName));
             continue;
         }
-        std::unique_ptr<Travel> currTravel = std::make_unique<Travel>(travelName);
-        map<string,vector<fs::path>> currPorts;
-        for(const auto &deep_entry : fs::directory_iterator(entry.path())){
-            string fileName = deep_entry.path().filename().string();
-            if(isValidPortFileName(fileName)){
-                string portName = extractPortNameFromFile(fileName);
-                int portNum = extractPortNumFromFile(fileName);
-                insertPortFile(currTravel,portName,portNum,deep_entry.path());
-            }
-            else if(isValidShipRouteFileName(fileName)){
-                    if(!currTravel->getRoutePath().empty())
-                        currTravel->setNewGeneralError(ERROR_ROUTE_MANY_FILES(fileName));
-                    else
-                        currTravel->setRoutePath(deep_entry.path());
+        travelDirs.emplace_back(entry.path());
+    }
+    if(streamWindow == 0){
+        prepareTravels(0, (int)travelDirs.size());
+        travelDirs.clear();
+    }
+}
+
+/**
+ * This function builds the travels of travelDirs[first]...travelDirs[last-1] at the end of TravelsVec,
+ * scanning their folders and parsing their plan and route concurrently.
+ */
+void SimulatorObj::prepareTravels(int first, int last){
+    int offset = (int)TravelsVec.size();
+    for(int i = first; i < last; i++)
+        TravelsVec.emplace_back(std::make_unique<Travel>(travelDirs[i].filename().string()));
+    runInParallel(last - first, numThreads, [this, first, offset](int index){
+        scanTravelDirectory(TravelsVec[offset + index], travelDirs[first + index]);
+        prepareTravel(TravelsVec[offset + index]);
+    });
+}
+
+/**
+ * This function runs runTravel on every travel by the travels order.
+ * at streaming mode travels are built streamWindow at a time, and every travel is freed right after it's results
+ * and errors are flushed, so memory doesn't grow with the number of travels.
+ */
+void SimulatorObj::forEachTravel(const std::function<void(std::unique_ptr<Travel>&)> &runTravel){
+    forEachTravelWindow([&runTravel](vector<std::unique_ptr<Travel>> &travels){
+        for(auto &travel : travels)
+            runTravel(travel);
+    });
+}
+
+/**
+ * This function runs runWindow on the travels, all of them at once unless at streaming mode
+ * where it's given streamWindow travels at a time, that are flushed and freed after it returns.
+ */
+void SimulatorObj::forEachTravelWindow(const std::function<void(vector<std::unique_ptr<Travel>>&)> &runWindow){
+    if(streamWindow == 0){
+        runWindow(TravelsVec);
+        return;
+    }
+    if(!generalErrors.empty())
+        openErrorsFile();
+    for(int first = 0; first < (int)travelDirs.size(); first += streamWindow){
+        prepareTravels(first, std::min(first + streamWindow, (int)travelDirs.size()));
+        runWindow(TravelsVec);
+        for(auto &travel : TravelsVec){
+            flushStreamedTravel(travel);
+            travel.reset();
+        }
+        TravelsVec.clear();
+    }
+    travelDirs.clear();
+}
+
+/**
+ * This function re-validates the <alg>_<travel>_crane_instructions folders already written at the output path,
+ * without running the algorithms, so simulation.results and simulation.errors can be rebuilt after the validation changed.
+ * every (travel, algorithm) pair is replayed concurrently by it's own worker simulator, and the results are merged
+ * to the travels by the pairs order.
+ * Note - the error codes the algorithms returned are not kept on disk, so errors comparing them vs the simulator
+ * error codes are not reported, neither are algorithms crashes.
+ */
+void SimulatorObj::validateExistingInstructions(){
+    forEachTravelWindow([this](vector<std::unique_ptr<Travel>> &travels){
+        vector<std::tuple<int,string,string>> folders;
+        collectInstructionFolders(travels, folders);
+        vector<map<string,pair<int,int>>> results(folders.size());
+        vector<ErrorList> errors(folders.size(), ErrorList(errorsCapPerCode));
+        runInParallel((int)folders.size(), numThreads, [this, &travels, &folders, &results, &errors](int index){
+            auto &[travelIndex, algName, folder] = folders[index];
+            SimulatorObj worker(this);
+            worker.replayAlgorithm(algName, folder, travels[travelIndex], results[index], errors[index]);
+        });
+        for(int i = 0; i < (int)folders.size(); i++){
+            auto &travel = travels[std::get<0>(folders[i])];
+            travel->getAlgResultsMap().insert(results[i].begin(), results[i].end());
+            travel->getErrorsMap().insert(make_pair(std::get<1>(folders[i]), errors[i]));
+        }
+    });
+}
+
+/**
+ * This function finds the crane instructions folders of the given (not erroneous) travels at the output path
+ * a folder belongs to the longest travel name (among all the travels, not only the given ones) it ends with,
+ * so <alg>_Travel_x_Travel2 is Travel_x_Travel2's and not Travel2's folder of algorithm <alg>_Travel_x.
+ * @param folders - filled with (travel index, algorithm name, folder path) sorted by travel and then algorithm
+ */
+void SimulatorObj::collectInstructionFolders(vector<std::unique_ptr<Travel>> &travels,vector<std::tuple<int,string,string>> &folders){
+    const string suffix = "_crane_instructions";
+    vector<string> travelNames;
+    for(auto &travel : travels)
+        travelNames.emplace_back(travel->getName());
+    for(auto &travelDir : travelDirs)
+        travelNames.emplace_back(travelDir.filename().string());
+    std::sort(travelNames.begin(), travelNames.end(), [](const string &a, const string &b){
+        return a.size() != b.size() ? a.size() > b.size() : a < b;
+    });
+    /*folder name --> the name of the travel it belongs to*/
+    map<string,string> folderTravel;
+    for(const auto &entry : fs::directory_iterator(mainOutputPath)){
+        string folderName = entry.path().filename().string();
+        if(!entry.is_directory() || folderName.size() <= suffix.size())
+            continue;
+        for(auto &travelName : travelNames){
+            string travelSuffix = "_" + travelName + suffix;
+            if(folderName.size() > travelSuffix.size() &&
+               folderName.compare(folderName.size() - travelSuffix.size(), travelSuffix.size(), travelSuffix) == 0){
+                folderTravel.emplace(folderName, travelName);
+                break;
             }
-            else if(isValidShipMapFileName(fileName)){
-                if(!currTravel->getPlanPath().empty())
-                    currTravel->setNewGeneralError(ERROR_PLAN_MANY_FILES(fileName));
+        }
+    }
+    for(int i = 0; i < (int)travels.size(); i++){
+        if(travels[i]->isErroneous())
+            continue;
+        string travelSuffix = "_" + travels[i]->getName() + suffix;
+        for(auto &[folderName, travelName] : folderTravel){
+            if(travelName == travels[i]->getName())
+                folders.emplace_back(i, folderName.substr(0, folderName.size() - travelSuffix.size()),
+                                     mainOutputPath + PATH_SEPARATOR + folderName);
+        }
+    }
+}
+
+/**
+ * This function replays the crane instructions folder of the given algorithm over the given travel, as runAlgorithm
+ * does without running the algorithm, it's called on a worker simulator with it's own ship built from the travel files
+ * so several pairs can be replayed concurrently, the travel itself is only read.
+ */
+void SimulatorObj::replayAlgorithm(const string &algName,const string &algInstructionsFolder,std::unique_ptr<Travel> &travel,
+                                   map<string,pair<int,int>> &algResults,ErrorList &simCurrAlgErrors){
+    std::unique_ptr<Travel> scratchTravel = std::make_unique<Travel>(travel->getName());
+    map<string,int> visitNumbersByPort;
+    int travelSimErrors = 0, res = 0;
+    scratchTravel->setPlanPath(travel->getPlanPath());
+    scratchTravel->setRoutePath(travel->getRoutePath());
+    std::unique_ptr<Ship> ship = extractArgsForShip(scratchTravel, travelSimErrors);
+    if(ship == nullptr)
+        return;
+    setShipAndCalculator(ship, travel->getPlanPath().string());
+    updateErrorCodes(travelSimErrors, "sim");
+    if(checkIfFatalErrorOccurred("sim") == -1)
+        return;
+    vector<std::shared_ptr<Port>> route = simShip->getRoute();
+    for (int portNum = 0; portNum < (int) route.size() && res != -1; portNum++) {
+        string portName = route[portNum]->get_name();
+        pPort = simShip->getPortByName(portName);
+        currPortNum = portNum;
+        int visitNumber = visitNumbersByPort[portName]++;
+        fs::path portPath = findPortFile(travel, portName, visitNumber);
+        /*Case there is no file --> the algorithm got an empty file*/
+        std::optional<string> portData = fs::exists(portPath) ? readFileToMemory(portPath.string()) : std::optional<string>(string());
+        string outputPath = algInstructionsFolder + PATH_SEPARATOR + portName + "_" + std::to_string(visitNumber + 1) + ".crane_instructions";
+        res = validateCurrentPort(algName, portName, portPath, portData, outputPath, simCurrAlgErrors, visitNumber + 1, algResults);
+    }
+}
+
+/**
+ * This function records the travel results and writes it's errors to the errors file, at streaming mode.
+ */
+void SimulatorObj::flushStreamedTravel(std::unique_ptr<Travel> &travel){
+    recordTravelResults(travel);
+    if(travel->getGeneralErrors().empty() && travel->getErrorsMap().empty())
+        return;
+    if(errorsFile.is_open() || openErrorsFile())
+        writeTravelErrors(travel);
+}
+
+/**
+ * This function classifies the files of a travel folder to cargo_data files, route file and plan file
+ */
+void SimulatorObj::scanTravelDirectory(std::unique_ptr<Travel> &currTravel, const fs::path &travelDir){
+    for(const auto &deep_entry : fs::directory_iterator(travelDir)){
+        string fileName = deep_entry.path().filename().string();
+        if(isValidPortFileName(fileName)){
+            string portName = extractPortNameFromFile(fileName);
+            int portNum = extractPortNumFromFile(fileName);
+            insertPortFile(currTravel,portName,portNum,deep_entry.path());
+        }
+        else if(isValidShipRouteFileName(fileName)){
+                if(!currTravel->getRoutePath().empty())
+                    currTravel->setNewGeneralError(ERROR_ROUTE_MANY_FILES(fileName));
                 else
-                    currTravel->setPlanPath(deep_entry.path());
+                    currTravel->setRoutePath(deep_entry.path());
+        }
+        else if(isValidShipMapFileName(fileName)){
+            if(!currTravel->getPlanPath().empty())
+                currTravel->setNewGeneralError(ERROR_PLAN_MANY_FILES(fileName));
+            else
+                currTravel->setPlanPath(deep_entry.path());
+        }
+        else{
+            currTravel->setNewGeneralError(ERROR_INVALID_FILE(fileName));
+        }
+    }
+}
+
+/**
+ * This function parses the plan and route of the travel and keeps the ship and the simulator error codes at the travel,
+ * if the ship could not be built the travel is marked as erroneous
+ */
+void SimulatorObj::prepareTravel(std::unique_ptr<Travel> &travel){
+    int travelSimErrors = 0;
+    std::unique_ptr<Ship> ship = extractArgsForShip(travel, travelSimErrors);
+    travel->setSimErrorCodes(travelSimErrors);
+    if(ship == nullptr)
+        travel->setErroneousTravel();
+    travel->setShip(std::move(ship));
+}
+
+/**
+ * This function runs task(0)...task(numOfTasks-1) over at most numOfThreads threads, the calling thread included,
+ * the first exception thrown by a task is rethrown at the calling thread after all threads finished.
+ */
+void SimulatorObj::runInParallel(int numOfTasks, int numOfThreads, const std::function<void(int)> &task){
+    std::atomic<int> nextTask{0};
+    std::mutex exceptionLock;
+    std::exception_ptr firstException;
+    auto worker = [&](){
+        for(int index = nextTask++; index < numOfTasks; index = nextTask++){
+            try {
+                task(index);
             }
-            else{
-                currTravel->setNewGeneralError(ERROR_INVALID_FILE(fileName));
+            catch(...){
+                std::lock_guard<std::mutex> guard(exceptionLock);
+                if(!firstException) firstException = std::current_exception();
             }
         }
-        this->TravelsVec.emplace_back(std::move(currTravel));
-
-    }
+    };
+    vector<std::thread> threads;
+    for(int i = 1; i < std::min(numOfThreads, numOfTasks); i++)
+        threads.emplace_back(worker);
+    worker();
+    for(auto &thread : threads)
+        thread.join();
+    if(firstException)
+        std::rethrow_exception(firstException);
 }
 
 /**
@@ -116,16 +337,17 @@ void SimulatorObj::createResultsFile(){
     std::ofstream inFile;
     int sumInstructions = 0,sumErrors = 0;
     const char comma = ',';
-    list<string> travels;
     list<string> algorithmNames;
     string path = mainOutputPath;
-    map<string,map<string,pair<int,int>>> output_map;
 
+    if(streamWindow == 0){
+        for(auto &travel : this->TravelsVec)
+            recordTravelResults(travel);
+    }
     if(isResultsEmpty()){
         NO_RESULT_FILE;
         return;
     }
-    initOutputMap(output_map);
     path.append(PATH_SEPARATOR);
     path.append("simulation.results");
     inFile.open(path);
@@ -133,32 +355,32 @@ void SimulatorObj::createResultsFile(){
         ERROR_RESULTS_FILE;
         exit(EXIT_FAILURE);
     }
-    for(auto &travel : this->TravelsVec) {//Get travel Names
-        if(!travel->isErroneous())
-            travels.emplace_back(travel->getName());
-    }
-    for(auto &algName : this->TravelsVec.front()->getAlgResultsMap())//Get algorithm names
-        algorithmNames.emplace_back(algName.first);
-
-    SimulatorObj::sortAlgorithmsForResults(output_map, algorithmNames);
+    algorithmNames = resultsAlgNames;
+    SimulatorObj::sortAlgorithmsForResults(resultsByTravel, algorithmNames);
 
     inFile << "RESULTS" << comma;
-    for(string &travel_name : travels)
+    for(string &travel_name : resultsTravelNames)
         inFile << travel_name << comma;
-    inFile << "Sum" << comma << "Errors" <<  '\n';
+    inFile << "Sum" << comma << "Errors";
+    if(!sampledValidation.empty())
+        inFile << comma << "Validation";
+    inFile << '\n';
 
     for(auto& algName : algorithmNames){
         inFile << algName << comma;
-        for(auto &travelName : travels){
-            if(output_map[travelName][algName].second == -1)
-                inFile << output_map[travelName][algName].second << comma;
+        for(auto &travelName : resultsTravelNames){
+            if(resultsByTravel[travelName][algName].second == -1)
+                inFile << resultsByTravel[travelName][algName].second << comma;
             else{
-                inFile << output_map[travelName][algName].first << comma;
-                sumInstructions += output_map[travelName][algName].first;
+                inFile << resultsByTravel[travelName][algName].first << comma;
+                sumInstructions += resultsByTravel[travelName][algName].first;
             }
-            sumErrors += output_map[travelName][algName].second;
+            sumErrors += resultsByTravel[travelName][algName].second;
         }
-        inFile << sumInstructions << comma << (sumErrors*-1) << '\n';
+        inFile << sumInstructions << comma << (sumErrors*-1);
+        if(!sampledValidation.empty())
+            inFile << comma << validationPolicyName(algName);
+        inFile << '\n';
         sumInstructions = 0;
         sumErrors = 0;
     }
@@ -169,60 +391,92 @@ void SimulatorObj::createResultsFile(){
  * This function creates a file that shows all the errors existed in the simulator run,
  * errors list - container didn't arrived to it's destination, container didn't picked up as the destination of
  * it isn't doesn't exist in any following ports
+ * at streaming mode the travels errors were already written while running, so it only closes the file.
  */
 void SimulatorObj::createErrorsFile() {
-    const string spaces = "      ";//6spaces
-    const string lineSep = "====================================================================================================";
-    std::ofstream inFile;
-    string path = mainOutputPath;
+    if(streamWindow > 0){
+        if(!errorsFile.is_open())
+            NO_ERROR_FILE
+        else
+            errorsFile.close();
+        return;
+    }
     if(isErrorsEmpty()){
         NO_ERROR_FILE;
         return;
     }
+    if(!openErrorsFile())
+        return;
+    for(auto &travel : TravelsVec)
+        writeTravelErrors(travel);
+    errorsFile.close();
+}
+
+/**
+ * This function opens simulation.errors and writes the simulator general errors at it's head
+ * @return true iff the file opened
+ */
+bool SimulatorObj::openErrorsFile(){
+    const string spaces = "      ";//6spaces
+    const string lineSep = "====================================================================================================";
+    string path = mainOutputPath;
     path.append(PATH_SEPARATOR);
     path.append("simulation.errors");
-    inFile.open(path);
-    if (inFile.fail()) {
+    errorsFile.open(path);
+    if (errorsFile.fail()) {
         ERROR_ERRORS_FILE;
-        return;
+        return false;
     }
     if(!generalErrors.empty()){
-        inFile << "Simulator General Errors:" << '\n';
+        errorsFile << "Simulator General Errors:" << '\n';
         for(auto &msg : generalErrors){
-            inFile << spaces << msg << '\n';
+            errorsFile << spaces << msg << '\n';
         }
-        inFile << lineSep+lineSep << '\n';
-    }
-    for(auto &travel : TravelsVec){
-        if(travel->isErrorsExists()){
-            inFile << travel->getName() << " Errors:" << '\n'; //Travel name
-            if(!travel->getGeneralErrors().empty()){
-                inFile << spaces << "General:" << '\n';
-                for(string &msg : travel->getGeneralErrors()){
-                    inFile << spaces + spaces << msg << '\n';
-                }
+        errorsFile << lineSep+lineSep << '\n';
+    }
+    return true;
+}
+
+/**
+ * This function writes the errors section of the given travel to simulation.errors
+ */
+void SimulatorObj::writeTravelErrors(std::unique_ptr<Travel> &travel){
+    const string spaces = "      ";//6spaces
+    const string lineSep = "====================================================================================================";
+    if(travel->isErrorsExists()){
+        errorsFile << travel->getName() << " Errors:" << '\n'; //Travel name
+        if(!travel->getGeneralErrors().empty()){
+            errorsFile << spaces << "General:" << '\n';
+            for(string &msg : travel->getGeneralErrors()){
+                errorsFile << spaces + spaces << msg << '\n';
             }
-            for(auto &pair : travel->getErrorsMap()){
-                if(!pair.second.empty()){
-                    inFile << spaces << pair.first + ":" << '\n'; //algorithm name
-                    for(string &msg : pair.second){
-                        inFile << spaces + spaces << msg << '\n'; //error msg list for this alg in this travel
-                    }
-                }
+        }
+        for(auto &pair : travel->getErrorsMap()){
+            if(!pair.second.empty()){
+                errorsFile << spaces << pair.first + ":" << '\n'; //algorithm name
+                pair.second.forEachMessage([this, &spaces](const string &msg){
+                    errorsFile << spaces + spaces << msg << '\n'; //error msg list for this alg in this travel
+                });
             }
-            inFile << lineSep+lineSep << '\n';
         }
+        errorsFile << lineSep+lineSep << '\n';
     }
-    inFile.close();
 }
 
 /**
- * This function initialize the output result map
+ * This function keeps the results of a finished travel, the algorithm names are taken from the first travel
  */
-void SimulatorObj::initOutputMap(map<string,map<string,pair<int,int>>>& outputMap){
-    for(auto& travel : this->TravelsVec){
-        if(!travel->isErroneous())
-            outputMap.insert(make_pair(travel->getName(),travel->getAlgResultsMap()));
+void SimulatorObj::recordTravelResults(std::unique_ptr<Travel> &travel){
+    if(!anyTravelRecorded){
+        for(auto &algName : travel->getAlgResultsMap())
+            resultsAlgNames.emplace_back(algName.first);
+        anyTravelRecorded = true;
+    }
+    if(!travel->getAlgResultsMap().empty())
+        resultsExist = true;
+    if(!travel->isErroneous()){
+        resultsTravelNames.emplace_back(travel->getName());
+        resultsByTravel.insert(make_pair(travel->getName(),travel->getAlgResultsMap()));
     }
 }
 
@@ -230,11 +484,7 @@ void SimulatorObj::initOutputMap(map<string,map<string,pair<int,int>>>& outputMa
  * This function checks if the results are empty --> if true simulation.results wont be created
  */
 bool SimulatorObj:: isResultsEmpty() {
-    for(auto& travel : this->TravelsVec)
-        if(!travel->getAlgResultsMap().empty())
-            return false;
-
-    return true;
+    return !resultsExist;
 }
 
 /**
@@ -251,27 +501,111 @@ bool SimulatorObj:: isErrorsEmpty(){
 
 /**
  * This function runs the current algorithm on the current travel
+ * while the algorithm and the validation work on a port, the cargo_data file of the next port is read to memory
+ * at the background, so the validator gets it without waiting and the algorithm reads it from a warm cache.
+ * if there's a validation cache and it holds this run, the stored results and errors are used instead of running,
+ * otherwise the run is stored to it (unless the algorithm failed).
+ * if the algorithm has a sampled validation policy, only the sampled port visits are fully validated (see runCurrentPort).
+ * at pipelined mode the validation of every port runs on a second thread while the algorithm works on the next port,
+ * the next port's work is dropped if the validated port turns out fatal, so the results are the same as the serial mode.
  */
 void SimulatorObj::runAlgorithm(pair<string,std::unique_ptr<AbstractAlgorithm>> &alg, std::unique_ptr<Travel> &travel){
-    list<string> simCurrAlgErrors;
+    ErrorList simCurrAlgErrors(errorsCapPerCode);
     map<string,int> visitNumbersByPort;
+    string cacheKey;
     int res = 0;
+    auto sampled = sampledValidation.find(alg.first);
+    currSampleEvery = sampled == sampledValidation.end() ? 1 : sampled->second;
+    prevAlgReturnValue = -1;
+    if(validationCache){
+        cacheKey = validationCache->makeKey(alg.first, travel, errorCodesSignature() + "/" + std::to_string(errorsCapPerCode) +
+                                                               "/" + std::to_string(currSampleEvery) +
+                                                               "/" + std::to_string(balanceThresholds.first) +
+                                                               "," + std::to_string(balanceThresholds.second));
+        std::optional<ValidationCache::Entry> cached = validationCache->lookup(cacheKey);
+        if(cached){
+            if(cached->results)
+                travel->getAlgResultsMap().insert_or_assign(alg.first, *cached->results);
+            travel->getErrorsMap().insert(make_pair(alg.first, cached->errors));
+            prepareNextIteration();
+            return;
+        }
+    }
     vector<std::shared_ptr<Port>> route = simShip->getRoute();
     res = checkIfFatalErrorOccurred("alg");
     if(res != -1) {
         string algInstructionsFolder = SimulatorObj::createAlgorithmOutDirectory(alg.first, mainOutputPath,travel->getName());
+        std::future<std::optional<string>> nextPortData;
+        std::future<int> prevValidation; /*pipelined --> the validation of the previous port*/
+        string prevPortName;
+        int prevVisitNumber = 0;
         for (int portNum = 0; portNum < (int) route.size() && res != -1; portNum++) {
             string portName = route[portNum]->get_name();
+            int visitNumber = visitNumbersByPort[portName]++;
+            fs::path portPath = getPathOfCurrentPort(travel,portName,visitNumber);
+            std::optional<string> portData = portNum == 0 ? readFileToMemory(portPath.string()) : nextPortData.get();
+            string outputPath = algInstructionsFolder + PATH_SEPARATOR + portName + "_" + std::to_string(visitNumber + 1) + ".crane_instructions";
+            std::optional<int> algReturnValue;
+            if(pipelined){
+                /*The algorithm works on this port while the previous port is validated*/
+                algReturnValue = runAlgorithmOverPort(alg, portPath.string(), outputPath);
+                if(prevValidation.valid()){
+                    res = prevValidation.get();
+                    compareIgnoredAlgErrsVsSimErrs(prevPortName, prevVisitNumber, simCurrAlgErrors);
+                    if(res == -1){
+                        /*Case the previous port was fatal --> the serial mode never runs this port*/
+                        std::error_code err;
+                        fs::remove(outputPath, err);
+                        break;
+                    }
+                }
+            }
+            if(portNum + 1 < (int) route.size()){
+                /*The next port's file is only looked up, a missing one is created when the port is visited*/
+                string nextPortName = route[portNum + 1]->get_name();
+                fs::path nextPortPath = findPortFile(travel,nextPortName,visitNumbersByPort[nextPortName]);
+                nextPortData = std::async(std::launch::async, [nextPortPath](){
+                    return fs::exists(nextPortPath) ? readFileToMemory(nextPortPath.string()) : std::optional<string>(string());
+                });
+            }
             pPort = simShip->getPortByName(portName);
             currPortNum = portNum;
-            int visitNumber = visitNumbersByPort[portName];
-            fs::path portPath = getPathOfCurrentPort(travel,portName,visitNumber);
-            res = runCurrentPort(portName, portPath, alg, simCurrAlgErrors, algInstructionsFolder,
-                                 ++visitNumbersByPort[portName],travel);
-            compareIgnoredAlgErrsVsSimErrs(portName, visitNumber, simCurrAlgErrors);
+            if(!pipelined){
+                res = runCurrentPort(portName, portPath, portData, alg, simCurrAlgErrors, algInstructionsFolder,
+                                     visitNumber + 1,travel);
+                compareIgnoredAlgErrsVsSimErrs(portName, visitNumber, simCurrAlgErrors);
+                continue;
+            }
+            if(!algReturnValue){
+                simCurrAlgErrors.add(ErrorCode::AlgFailed);
+                compareIgnoredAlgErrsVsSimErrs(portName, visitNumber, simCurrAlgErrors);
+                res = -1;
+                break;
+            }
+            updateErrorCodes(*algReturnValue, "alg");
+            bool fullValidation = isFullValidationVisit(*algReturnValue);
+            prevValidation = std::async(std::launch::async, [this, &alg, &simCurrAlgErrors, &travel, portName, portPath, outputPath, visitNumber,
+                                                             fullValidation, portData = std::move(portData)]() mutable {
+                return validateCurrentPort(alg.first, portName, portPath, portData, outputPath, simCurrAlgErrors, visitNumber + 1,
+                                           travel->getAlgResultsMap(), fullValidation);
+            });
+            prevPortName = portName;
+            prevVisitNumber = visitNumber;
+        }
+        if(prevValidation.valid()){
+            res = prevValidation.get();
+            compareIgnoredAlgErrsVsSimErrs(prevPortName, prevVisitNumber, simCurrAlgErrors);
         }
     }
     compareFatalAlgErrsVsSimErrs(simCurrAlgErrors);
+    if(validationCache && !simCurrAlgErrors.contains(ErrorCode::AlgFailed)){
+        ValidationCache::Entry entry;
+        auto results = travel->getAlgResultsMap().find(alg.first);
+        if(results != travel->getAlgResultsMap().end())
+            entry.results = results->second;
+        entry.errors = simCurrAlgErrors;
+        validationCache->store(cacheKey, entry);
+    }
     travel->getErrorsMap().insert(make_pair(alg.first,simCurrAlgErrors));
     prepareNextIteration();
 }
@@ -306,6 +640,18 @@ fs::path SimulatorObj::getPathOfCurrentPort(std::unique_ptr<Travel> &travel,stri
     return result;
 }
 
+/**
+ * This function gets the full file path of the given port in the given travel at the X time we visit there,
+ * as getPathOfCurrentPort does but it neither changes the travel nor creates missing files
+ */
+fs::path SimulatorObj::findPortFile(std::unique_ptr<Travel> &travel,const string& portName,int visitNumber){
+    auto &travelMap = travel->getMap();
+    auto portFiles = travelMap.find(portName);
+    if(portFiles != travelMap.end() && visitNumber < (int)portFiles->second.size() && !portFiles->second[visitNumber].empty())
+        return portFiles->second[visitNumber];
+    return fs::path(travel->getPlanPath().parent_path().string() + PATH_SEPARATOR + portName + "_" + std::to_string(visitNumber+1) + ".cargo_data");
+}
+
 int SimulatorObj::checkIfFatalErrorOccurred(string type){
     if(type == "alg" && (algErrorCodes[3] || algErrorCodes[4] || algErrorCodes[7] || algErrorCodes[8]))
         return -1;
@@ -318,58 +664,91 @@ int SimulatorObj::checkIfFatalErrorOccurred(string type){
 /**
  *  This function compares the fatal errors between algorithm and simulator
  */
-void SimulatorObj::compareFatalAlgErrsVsSimErrs(list<string> &simCurrAlgErrors){
+void SimulatorObj::compareFatalAlgErrsVsSimErrs(ErrorList &simCurrAlgErrors){
     if(algErrorCodes[3] != simErrorCodes[3])
-        simCurrAlgErrors.emplace_back(ERROR_PLAN_FATAL);
+        simCurrAlgErrors.add(ErrorCode::PlanFatal);
     if(algErrorCodes[4] != simErrorCodes[4])
-        simCurrAlgErrors.emplace_back(ERROR_DUPLICATE_XY);
+        simCurrAlgErrors.add(ErrorCode::DuplicateXY);
     if(algErrorCodes[7] != simErrorCodes[7])
-        simCurrAlgErrors.emplace_back(ERROR_TRAVEL_FATAL);
+        simCurrAlgErrors.add(ErrorCode::TravelFatal);
     if(algErrorCodes[8] != simErrorCodes[8])
-        simCurrAlgErrors.emplace_back(ERROR_TRAVEL_SINGLEPORT);
+        simCurrAlgErrors.add(ErrorCode::TravelSinglePort);
 }
 
 /**
  * This function compares ignored errors between algorithm and simulator
  */
-void SimulatorObj::compareIgnoredAlgErrsVsSimErrs(string &portName,int visitNumber,list<string> &simCurrAlgErrors){
+void SimulatorObj::compareIgnoredAlgErrsVsSimErrs(string &portName,int visitNumber,ErrorList &simCurrAlgErrors){
     if(algErrorCodes[16] != simErrorCodes[16])
-        simCurrAlgErrors.emplace_back(ERROR_NO_CARGO_TOLOAD(portName, visitNumber));
+        simCurrAlgErrors.add(ErrorCode::NoCargoToLoad, portName, string(), string(), visitNumber);
 }
 
 /**
  * This function runs the current algorithm over the current port at the travel route
  */
-int SimulatorObj::runCurrentPort(string &portName,fs::path &portPath,pair<string,std::unique_ptr<AbstractAlgorithm>> &alg,
-                    list<string> &simCurrAlgErrors,string &algOutputFolder,int visitNumber,std::unique_ptr<Travel> &travel){
+int SimulatorObj::runCurrentPort(string &portName,fs::path &portPath,const std::optional<string> &portData,pair<string,std::unique_ptr<AbstractAlgorithm>> &alg,
+                    ErrorList &simCurrAlgErrors,string &algOutputFolder,int visitNumber,std::unique_ptr<Travel> &travel){
 
-    string inputPath,outputPath;
-    int instructionsCount, errorsCount, algReturnValue;
-    std::optional<pair<int,int>> result;
-    pair<int,int> intAndError;
-    SimulatorValidation validator(this);
-    inputPath =  portPath.string();
+    string outputPath;
     outputPath = algOutputFolder + PATH_SEPARATOR + portName + "_" + std::to_string(visitNumber) + ".crane_instructions";
 
+    std::optional<int> algReturnValue = runAlgorithmOverPort(alg, portPath.string(), outputPath);
+    if(!algReturnValue){
+        simCurrAlgErrors.add(ErrorCode::AlgFailed);
+        return -1;
+    }
+    updateErrorCodes(*algReturnValue, "alg");
+    bool fullValidation = isFullValidationVisit(*algReturnValue);
+    return validateCurrentPort(alg.first, portName, portPath, portData, outputPath, simCurrAlgErrors, visitNumber,
+                               travel->getAlgResultsMap(), fullValidation);
+}
+
+/**
+ * This function runs the algorithm over the cargo_data file at inputPath
+ * @return the error codes the algorithm returned, or nullopt if it crashed
+ */
+std::optional<int> SimulatorObj::runAlgorithmOverPort(pair<string,std::unique_ptr<AbstractAlgorithm>> &alg,const string &inputPath,const string &outputPath){
     try {
-        algReturnValue = alg.second->getInstructionsForCargo(inputPath,outputPath);
+        return alg.second->getInstructionsForCargo(inputPath,outputPath);
     }
     catch(...){
-        simCurrAlgErrors.emplace_back(ERROR_ALG_FAILED);
-        return -1;
+        return std::nullopt;
     }
-    updateErrorCodes(algReturnValue, "alg");
-    result = validator.validateAlgorithm(outputPath,inputPath,simCurrAlgErrors,portName,visitNumber);
+}
+
+/**
+ * This function checks if the current port visit is fully validated, always unless the algorithm has a sampled policy,
+ * then only at the sampled visits, the last visit and whenever the returned error codes change
+ */
+bool SimulatorObj::isFullValidationVisit(int algReturnValue){
+    bool fullValidation = currSampleEvery <= 1 || currPortNum % currSampleEvery == 0 || algReturnValue != prevAlgReturnValue ||
+                          currPortNum + 1 == (int)simShip->getRoute().size();
+    prevAlgReturnValue = algReturnValue;
+    return fullValidation;
+}
+
+/**
+ * This function validates the crane instructions file of the current port and adds the instructions count and
+ * errors count to the algorithm results
+ */
+int SimulatorObj::validateCurrentPort(const string &algName,string &portName,fs::path &portPath,const std::optional<string> &portData,string &outputPath,
+                                      ErrorList &simCurrAlgErrors,int visitNumber,map<string,pair<int,int>> &algResults,bool fullValidation){
+    string inputPath = portPath.string();
+    int instructionsCount, errorsCount;
+    std::optional<pair<int,int>> result;
+    pair<int,int> intAndError;
+    SimulatorValidation validator(this);
+    result = validator.validateAlgorithm(outputPath,inputPath,portData,simCurrAlgErrors,portName,visitNumber,fullValidation);
     if(!result) return -1; //case there was an error in validateAlgorithm
 
     /*Incrementing the instructions count and errors count*/
     intAndError = result.value();
     instructionsCount = std::get<0>(intAndError);
     errorsCount = std::get<1>(intAndError);
-    if(travel->getAlgResultsMap().find(alg.first) == travel->getAlgResultsMap().end())
-        travel->getAlgResultsMap().insert(make_pair(alg.first,pair<int,int>()));
-    std::get<0>(travel->getAlgResultsMap()[alg.first]) += instructionsCount;
-    std::get<1>(travel->getAlgResultsMap()[alg.first]) += errorsCount;
+    if(algResults.find(algName) == algResults.end())
+        algResults.insert(make_pair(algName,pair<int,int>()));
+    std::get<0>(algResults[algName]) += instructionsCount;
+    std::get<1>(algResults[algName]) += errorsCount;
 
     this->pPort->getContainerVec(Type::PRIORITY)->clear();
     this->pPort->getContainerVec(Type::LOAD)->clear();
@@ -401,10 +780,79 @@ void SimulatorObj:: prepareNextIteration() {
     this->currPortNum = 0;
 }
 
-WeightBalanceCalculator SimulatorObj::getCalc() {
+/**
+ * This function returns the weight balance calculator of the current run, the validator registers the approved
+ * operations on it so it follows the ship map through the whole travel
+ */
+WeightBalanceCalculator& SimulatorObj::getCalc() {
     return simCalc;
 }
 
+CargoDataTable& SimulatorObj::getCargoData() {
+    return cargoData;
+}
+
+void SimulatorObj::setValidationCache(std::unique_ptr<ValidationCache> cache) {
+    validationCache = std::move(cache);
+}
+
+/**
+ * This function sets the imbalance thresholds (in columns) of the simulator's weight balance calculator
+ */
+void SimulatorObj::setBalanceThresholds(double maxOffsetX, double maxOffsetY) {
+    simCalc.setImbalanceThresholds(maxOffsetX, maxOffsetY);
+    balanceThresholds = {maxOffsetX, maxOffsetY};
+}
+
+/**
+ * This function sets the pipelined mode, validating every port while the algorithm works on the next one
+ */
+void SimulatorObj::setPipelined(bool pipelinedMode) {
+    pipelined = pipelinedMode;
+}
+
+/**
+ * This function sets the algorithms validated by a sampled validation policy, algorithm name --> 1 out of every N
+ * port visits is fully validated (N <= 1 --> every visit is)
+ */
+void SimulatorObj::setSampledValidation(const map<string,int> &sampleEvery) {
+    sampledValidation.clear();
+    for(auto &alg : sampleEvery)
+        if(alg.second > 1)
+            sampledValidation.insert(alg);
+}
+
+/**
+ * This function returns the validation policy of the given algorithm as written to simulation.results,
+ * "full" or "sampled 1/N" so sampled scores are never mistaken for fully validated ones
+ */
+string SimulatorObj::validationPolicyName(const string &algName) {
+    auto sampled = sampledValidation.find(algName);
+    if(sampled == sampledValidation.end())
+        return "full";
+    return "sampled 1/" + std::to_string(sampled->second);
+}
+
+/**
+ * This function sets the max number of errors kept per error code for each algorithm at each travel,
+ * the errors above it are only counted, so a runaway algorithm can't exhaust the memory (0 --> no cap)
+ */
+void SimulatorObj::setErrorsCap(size_t cap) {
+    errorsCapPerCode = cap;
+}
+
+/**
+ * This function returns the algorithm and simulator error codes as a string of 0/1, used for the validation cache key
+ */
+string SimulatorObj::errorCodesSignature() {
+    string signature;
+    for(bool code : algErrorCodes)
+        signature += code ? '1' : '0';
+    for(bool code : simErrorCodes)
+        signature += code ? '1' : '0';
+    return signature;
+}
+
 /**
  * This function sorts the algorithms output info list and assigning the order to the algorithms list
  * such that:
@@ -467,26 +915,32 @@ std::shared_ptr<Port> SimulatorObj::getPort() {
 /**
  * This function sorts the given vector of containers by the it's distance from it's destination
  * first occurences will be containers with lowest distance...
+ * the distance is the index of the next visit of the destination at the route, a small integer, so the containers
+ * are bucket sorted by it in O(n + route length), containers with the same distance keep their order.
  */
 void SimulatorObj::sortContainersByPriority(vector<Container>* &priorityVec){
     auto routeVec = this->getShip()->getRoute();
-    map<string,int> portNamePriority;
-    for(int i = currPortNum+1; i < (int)routeVec.size(); i++){
-        if(portNamePriority.find((*routeVec[i]).get_name()) == portNamePriority.end())
-            portNamePriority.insert({routeVec[i]->get_name(),i});
-    }
-    std::sort(priorityVec->begin(),priorityVec->end(),[&portNamePriority](Container& cont1,Container& cont2) -> bool
-    {
-        string cont1PortDst = cont1.getDest()->get_name();
-        string cont2PortDst = cont2.getDest()->get_name();
-        if(portNamePriority.find(cont1PortDst) == portNamePriority.end())
-            portNamePriority.insert({cont1PortDst,INT_MAX});
-        if(portNamePriority.find(cont2PortDst) == portNamePriority.end())
-            portNamePriority.insert({cont2PortDst,INT_MAX});
-        return portNamePriority[cont1PortDst] < portNamePriority[cont2PortDst];
-
-    });
-
+    int notInRoute = (int)routeVec.size(); /*last bucket*/
+    std::unordered_map<string,int> portNamePriority;
+    for(int i = currPortNum+1; i < (int)routeVec.size(); i++)
+        portNamePriority.emplace(routeVec[i]->get_name(), i); /*keeps the first visit*/
+    vector<int> bucketStart(notInRoute + 2, 0);
+    vector<int> priorities(priorityVec->size());
+    for(int i = 0; i < (int)priorityVec->size(); i++){
+        auto priority = portNamePriority.find((*priorityVec)[i].getDest()->get_name());
+        priorities[i] = priority == portNamePriority.end() ? notInRoute : priority->second;
+        bucketStart[priorities[i] + 1]++;
+    }
+    for(int bucket = 1; bucket < (int)bucketStart.size(); bucket++)
+        bucketStart[bucket] += bucketStart[bucket - 1];
+    vector<int> order(priorityVec->size());
+    for(int i = 0; i < (int)priorityVec->size(); i++)
+        order[bucketStart[priorities[i]]++] = i;
+    vector<Container> sorted;
+    sorted.reserve(priorityVec->size());
+    for(int i : order)
+        sorted.emplace_back(std::move((*priorityVec)[i]));
+    priorityVec->swap(sorted);
 }
 
 int SimulatorObj::getPortNum(){
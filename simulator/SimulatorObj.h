@@ -9,8 +9,14 @@
 * setShipAndCalculator          - sets the ship of the simulator and the calculator
 * createResultsFile             - creates the results file simulation.results
 * createErrorsFile              - creates the errors file simulation.errors
+* forEachTravel                 - runs a given function over the travels, lazily at streaming mode
+* forEachTravelWindow           - runs a given function over windows of travels, a single window unless at streaming mode
+* validateExistingInstructions  - re-validates the crane instructions folders already at the output path (-validate_only)
+* replayAlgorithm               - re-validates the crane instructions folder of one algorithm over one travel
+* collectInstructionFolders     - finds the <alg>_<travel>_crane_instructions folders of the given travels
 * runAlgorithm                  - run the current algorithm on current travel
 * runCurrentPort                - run the current algorithm in the current travel on the current port
+* validateCurrentPort           - validates the crane instructions of the current port and adds it's results
 * updateErrorCodes              - updates sim array of codes or alg array of codes
 * prepareNextIteration          - reset the relevant data members to next iteration
 * checkIfFatalErrorOccurred     - checks if fatal error occures in simulator
@@ -22,6 +28,16 @@
 * getPathOfCurrentPort              - getting the path of the current port cargo_data file
 * sortAlgorithmsForResults          - sorts the algorithm results list
 * compareRoutePortsVsCargoDataPorts - comparing amount of route ports vs amount of cargo_data files
+* runInParallel                     - runs indexed tasks over a given number of threads
+* setValidationCache                - sets the on disk cache of algorithm over travel runs
+* errorCodesSignature               - the current simulator and algorithm error codes as string
+* setErrorsCap                      - sets the max number of errors kept per error code, for each algorithm at each travel
+* setSampledValidation              - sets the algorithms validated by a sampled validation policy
+* setBalanceThresholds              - sets the imbalance thresholds of the simulator's weight balance calculator
+* setPipelined                      - sets validating a port on a second thread while the algorithm works on the next one
+* runAlgorithmOverPort              - runs the algorithm over a port, catching it's crashes
+* isFullValidationVisit             - checks if the current port visit is fully validated by the algorithm's policy
+* validationPolicyName              - the validation policy of an algorithm as written to simulation.results
  */
 
 class Common;
@@ -36,9 +52,19 @@ class SimulatorValidation;
 #include <fstream>
 #include "../interfaces/AbstractAlgorithm.h"
 #include "../common/Common.h"
+#include "../common/CargoDataTable.h"
 #include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <future>
+#include <optional>
+#include <unordered_map>
 #include "../interfaces/WeightBalanceCalculator.h"
 #include "Travel.h"
+#include "ErrorRecord.h"
+#include "ValidationCache.h"
 #include "SimulatorValidation.h"
 
 
@@ -69,44 +95,92 @@ class SimulatorObj {
     std::unique_ptr<Ship> simShip = nullptr;
     std::shared_ptr<Port> pPort = nullptr; /*holds the current port*/
     list<string> generalErrors;
-    WeightBalanceCalculator simCalc;
+    WeightBalanceCalculator simCalc; /*the calculator of the current run, owned by this simulator (every worker has it's own)*/
+    pair<double,double> balanceThresholds{NO_BALANCE_LIMIT, NO_BALANCE_LIMIT}; /*the thresholds simCalc was set with*/
     string mainOutputPath;
     string mainTravelPath;
     int currPortNum = 0;
+    int numThreads = 1;
+    int streamWindow = 0; /*0 --> all travels are kept until the end, otherwise number of travels loaded at once*/
+    vector<fs::path> travelDirs; /*travel folders that are not built yet*/
+    /*results of finished travels, kept after the travels are freed*/
+    map<string,map<string,pair<int,int>>> resultsByTravel;
+    list<string> resultsTravelNames;
+    list<string> resultsAlgNames;
+    bool anyTravelRecorded = false;
+    bool resultsExist = false;
+    std::ofstream errorsFile;
+    CargoDataTable cargoData; /*raw cargo_data lines of the port being validated, storage reused across ports*/
+    std::unique_ptr<ValidationCache> validationCache; /*nullptr --> runs are not cached*/
+    size_t errorsCapPerCode = 0; /*0 --> all errors are kept*/
+    /*algorithm name --> 1 out of every N port visits is fully validated, the rest get a lightweight check only,
+     *algorithms not in the map are fully validated at every visit*/
+    map<string,int> sampledValidation;
+    int currSampleEvery = 1;
+    int prevAlgReturnValue = -1;
+    bool pipelined = false;
 
 public:
-    SimulatorObj(string mainTravelPath, string outputPath): mainOutputPath(outputPath), mainTravelPath(mainTravelPath){
+    SimulatorObj(string mainTravelPath, string outputPath, int numThreads = 1, int streamWindow = 0): mainOutputPath(outputPath),
+        mainTravelPath(mainTravelPath), numThreads(std::max(numThreads, 1)), streamWindow(std::max(streamWindow, 0)){
         initListOfTravels(mainTravelPath);
     };
     void setShipAndCalculator(std::unique_ptr<Ship> &getShip,const string& file_path);
     void createResultsFile();
     void createErrorsFile();
     void runAlgorithm(pair<string,std::unique_ptr<AbstractAlgorithm>> &alg, std::unique_ptr<Travel> &travel);
-    int  runCurrentPort(string &portName,fs::path &portPath,pair<string,std::unique_ptr<AbstractAlgorithm>> &alg,
-                                      list<string> &simCurrAlgErrors,string &algOutputFolder,int visitNumber,std::unique_ptr<Travel> &travel);
+    int  runCurrentPort(string &portName,fs::path &portPath,const std::optional<string> &portData,pair<string,std::unique_ptr<AbstractAlgorithm>> &alg,
+                                      ErrorList &simCurrAlgErrors,string &algOutputFolder,int visitNumber,std::unique_ptr<Travel> &travel);
     void updateErrorCodes(int num, string type);
     void prepareNextIteration();
     int  checkIfFatalErrorOccurred(string type);
-    void compareFatalAlgErrsVsSimErrs(list<string> &simCurrAlgErrors);
-    void compareIgnoredAlgErrsVsSimErrs(string &portName, int visitNumber, list<string> &simCurrAlgErrors);
+    void compareFatalAlgErrsVsSimErrs(ErrorList &simCurrAlgErrors);
+    void compareIgnoredAlgErrsVsSimErrs(string &portName, int visitNumber, ErrorList &simCurrAlgErrors);
     void sortContainersByPriority(vector<Container>* &priorityVec);
     int getPortNum();
-    WeightBalanceCalculator getCalc();
+    WeightBalanceCalculator& getCalc();
+    CargoDataTable& getCargoData();
     vector<std::unique_ptr<Travel>>& getTravels();
+    void forEachTravel(const std::function<void(std::unique_ptr<Travel>&)> &runTravel);
+    void forEachTravelWindow(const std::function<void(vector<std::unique_ptr<Travel>>&)> &runWindow);
+    void validateExistingInstructions();
+    void setValidationCache(std::unique_ptr<ValidationCache> cache);
+    void setErrorsCap(size_t cap);
+    void setSampledValidation(const map<string,int> &sampleEvery);
+    void setPipelined(bool pipelinedMode);
+    void setBalanceThresholds(double maxOffsetX, double maxOffsetY);
     std::unique_ptr<Ship>& getShip();
     std::shared_ptr<Port> getPort();
     /*----------------------static functions-------------------*/
     static void insertPortFile(std::unique_ptr<Travel> &currTravel,string &portName, int portNum, const fs::path &entry);
     static string createAlgorithmOutDirectory(const string &algName,const string &outputDirectory,const string &travelName);
     static fs::path getPathOfCurrentPort(std::unique_ptr<Travel> &travel,string& portName,int visitNumber);
+    static fs::path findPortFile(std::unique_ptr<Travel> &travel,const string& portName,int visitNumber);
     static void sortAlgorithmsForResults(map<string,map<string,pair<int,int>>>&outputInfo, list<string> &algorithm);
     static void compareRoutePortsVsCargoDataPorts(std::unique_ptr<Ship>& ship,std::unique_ptr<Travel> &travel);
+    static void runInParallel(int numOfTasks, int numOfThreads, const std::function<void(int)> &task);
 
 private:
+    explicit SimulatorObj(const SimulatorObj* parent);
+    int  validateCurrentPort(const string &algName,string &portName,fs::path &portPath,const std::optional<string> &portData,string &outputPath,
+                             ErrorList &simCurrAlgErrors,int visitNumber,map<string,pair<int,int>> &algResults,bool fullValidation = true);
+    void replayAlgorithm(const string &algName,const string &algInstructionsFolder,std::unique_ptr<Travel> &travel,
+                         map<string,pair<int,int>> &algResults,ErrorList &simCurrAlgErrors);
+    void collectInstructionFolders(vector<std::unique_ptr<Travel>> &travels,vector<std::tuple<int,string,string>> &folders);
+    string errorCodesSignature();
+    string validationPolicyName(const string &algName);
+    bool isFullValidationVisit(int algReturnValue);
+    static std::optional<int> runAlgorithmOverPort(pair<string,std::unique_ptr<AbstractAlgorithm>> &alg,const string &inputPath,const string &outputPath);
     bool isErrorsEmpty();
     bool isResultsEmpty();
-    void initOutputMap(map<string,map<string,pair<int,int>>>& outputMap);
     void initListOfTravels(string &path);
+    void prepareTravels(int first, int last);
+    void flushStreamedTravel(std::unique_ptr<Travel> &travel);
+    void recordTravelResults(std::unique_ptr<Travel> &travel);
+    bool openErrorsFile();
+    void writeTravelErrors(std::unique_ptr<Travel> &travel);
+    static void scanTravelDirectory(std::unique_ptr<Travel> &currTravel, const fs::path &travelDir);
+    static void prepareTravel(std::unique_ptr<Travel> &travel);
 
 };
 
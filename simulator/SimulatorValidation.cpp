@@ -1,17 +1,29 @@
 #include "SimulatorValidation.h"
 
+SimulatorValidation::SimulatorValidation(SimulatorObj* simToCopy):rawDataFromPortFile(simToCopy->getCargoData()),sim(simToCopy),
+    calc(simToCopy->getCalc()){}
+
 /**
  * This function manages to validate the whole algorithm crane instruction at given port
+ * contAtPortData is the content of the cargo_data file at contAtPortPath, already read to memory by the simulator
+ * if fullValidation is false (a port visit not sampled by a sampled validation policy) only the instructions count
+ * and checkInstructionStructure are checked, so the ship map stays in sync for the next visits, errors count is 0.
  */
-std::optional<pair<int,int>> SimulatorValidation::validateAlgorithm(string &outputPath, string &contAtPortPath,
-                                               list<string>& currAlgErrors,string& portName,int visitNumber){
+std::optional<pair<int,int>> SimulatorValidation::validateAlgorithm(string &outputPath, string &contAtPortPath, const std::optional<string> &contAtPortData,
+                                               ErrorList& currAlgErrors,string& portName,int visitNumber,bool fullValidation){
     std::ifstream instructionsFile;
-    string line,id,instruction;
+    string line,id;
+    CraneInstruction instruction;
     int errorsCount = 0,instructionsCount = 0;
 
-    extractRawDataFromPortFile(rawDataFromPortFile, contAtPortPath,sim);
-    initLoadedListAndRejected();
-    initPriorityRejected();
+    rawDataFromPortFile.clear();
+    extractRawDataFromPortFile(rawDataFromPortFile, contAtPortPath, contAtPortData, sim);
+    initShipIndex();
+    if(fullValidation){
+        initOpenColumns();
+        initLoadedListAndRejected();
+        initPriorityRejected();
+    }
 
     instructionsFile.open(outputPath);
     if(instructionsFile.fail()) {
@@ -19,41 +31,49 @@ std::optional<pair<int,int>> SimulatorValidation::validateAlgorithm(string &outp
         return std::nullopt;
     }
     while(getline(instructionsFile, line)){
-        vector<int> coordinates;
-        extractCraneInstruction(line, instruction,id, coordinates);
+        if(!decodeCraneInstruction(line, instruction)){
+            if(instruction.status == InstructionStatus::EmptyLine)
+                continue;
+            currAlgErrors.add(ErrorCode::BadInstructionLine, line, portName, string(), visitNumber);
+            errorsCount = -1;
+            break;
+        }
+        id.assign(instruction.id);
+        char action = instruction.action;
+        auto &coordinates = instruction.coordinates;
         /*if the below statement pass test, then we can execute instruction or if it's reject then do nothing as we need to reject*/
-        if(validateInstruction(instruction, id, coordinates)){
-            if(instruction == "R"){
-                eraseFromRawData(line,id);
+        if(fullValidation ? validateInstruction(instruction, id) : checkInstructionStructure(instruction, id)){
+            if(action == 'R'){
+                eraseFromRawData(id);
                 continue;
             }
             coordinate one = std::tuple<int,int>(coordinates[1],coordinates[2]);
-            std::unique_ptr<Container> cont = createContainer(sim,rawDataFromPortFile,id,instruction,portName);
-            if(instruction == "L") {
-                execute(instruction.at(0), cont, one, std::forward_as_tuple(-1, -1));
+            std::unique_ptr<Container> cont = createContainer(id,action,portName);
+            if(action == 'L') {
+                execute(action, cont, one, std::forward_as_tuple(-1, -1));
                 instructionsCount+=5;
             }
-            else if(instruction == "U"){
-                execute(instruction.at(0), cont, one, std::forward_as_tuple(-1, -1));
+            else if(action == 'U'){
+                execute(action, cont, one, std::forward_as_tuple(-1, -1));
                 instructionsCount+=5;
             }
-            else if(instruction == "M"){
+            else if(action == 'M'){
                 coordinate two = std::tuple<int,int>(coordinates[4],coordinates[5]);
-                execute(instruction.at(0), cont, one, two);
+                execute(action, cont, one, two);
                 instructionsCount+=3;
 
             }
-            eraseFromRawData(line,id);
+            eraseFromRawData(id);
         }
         else{
-            currAlgErrors.emplace_back(ERROR_CONT_LINE_INSTRUCTION(portName, id, visitNumber, instruction));
+            currAlgErrors.add(ErrorCode::ContLineInstruction, portName, id, string(), visitNumber, action);
             errorsCount = -1;
             break;
         }
     }
     instructionsFile.close();
     /*Final checks*/
-    if(errorsCount != -1)
+    if(errorsCount != -1 && fullValidation)
         errorsCount  = finalChecks(currAlgErrors,portName,visitNumber);
 
     return {std::pair<int,int>(instructionsCount,errorsCount)};
@@ -62,20 +82,21 @@ std::optional<pair<int,int>> SimulatorValidation::validateAlgorithm(string &outp
 /**
  * This function manages to valid all types of instructions given by algorithm to port crane
  */
-bool SimulatorValidation::validateInstruction(string &instruction,string &id, vector<int> &coordinates){
+bool SimulatorValidation::validateInstruction(const CraneInstruction &instruction,string &id){
     bool isValid;
-    int kg = extractKgToValidate(rawDataFromPortFile,sim,id);
+    auto &coordinates = instruction.coordinates;
+    int kg = extractKgToValidate(id);
 
-    if(instruction == "L")
+    if(instruction.action == 'L')
         isValid =  validateLoadInstruction(coordinates,kg,id);
 
-    else if(instruction == "U")
+    else if(instruction.action == 'U')
         isValid =  validateUnloadInstruction(coordinates);
 
-    else if(instruction == "R")
+    else if(instruction.action == 'R')
         isValid = validateRejectInstruction(id,kg);
 
-    else if(instruction == "M"){
+    else if(instruction.action == 'M'){
         isValid = validateMoveInstruction(coordinates);
     }
     else
@@ -83,21 +104,52 @@ bool SimulatorValidation::validateInstruction(string &instruction,string &id, ve
     return isValid;
 }
 
+/**
+ * This function checks only that the crane can perform the instruction on the ship map: the positions are in the ship,
+ * a loaded container is known at the port and lands on top of it's column, an unloaded/moved one is on top of it's column,
+ * and that the calculator approves it (registering it, so the calculator keeps following the ship map)
+ * the priority and reject rules are not checked
+ */
+bool SimulatorValidation::checkInstructionStructure(const CraneInstruction &instruction,string &id){
+    auto &coordinates = instruction.coordinates;
+    auto &ship = sim->getShip();
+    auto &map = ship->getMap();
+    int realX = ship->getAxis("x"), realY = ship->getAxis("y");
+    auto isOnShip = [realX, realY](int x, int y){ return x >= 0 && x < realX && y >= 0 && y < realY; };
+    int z1 = coordinates[0],x1 = coordinates[1],y1 = coordinates[2];
+    switch(instruction.action){
+        case 'R':
+            return true;
+        case 'L':
+            return isOnShip(x1, y1) && (int)map[x1][y1].size() == z1 &&
+                   (rawDataFromPortFile.contains(id) || sim->getPort()->findContainer(id, Type::PRIORITY) != nullptr) &&
+                   calc.tryOperation('L', extractKgToValidate(id), x1, y1) == APPROVED;
+        case 'U':
+            return isOnShip(x1, y1) && (int)map[x1][y1].size() == z1 + 1 && map[x1][y1][z1].getId() != "block" &&
+                   calc.tryOperation('U', map[x1][y1][z1].getWeight(), x1, y1) == APPROVED;
+        case 'M':
+            return validateMoveInstruction(coordinates);
+        default:
+            return false;
+    }
+}
+
 /**
  * This function validates reject crane instruction given by the algorithm
  */
 bool SimulatorValidation::validateRejectInstruction(string& id,int kg){
-    string line;
+    std::string_view line;
     auto &ship = sim->getShip();
-    string portName = extractPortNameToValidate(rawDataFromPortFile,sim,id);
-    std::tuple<int,int,int> tup = sim->getShip()->getCoordinate(id);
-    if(rawDataFromPortFile.find(id) != rawDataFromPortFile.end())
-        line = rawDataFromPortFile[id].front();
+    std::tuple<int,int,int> tup = getShipLocation(id);
+    int entry = rawDataFromPortFile.find(id);
+    if(entry != CargoDataTable::npos && rawDataFromPortFile.size(entry) > 0)
+        line = rawDataFromPortFile.front(entry);
     /*Case the data is not validate / duplicate Id / idExist on ship*/
-    if(!line.empty() && mustRejected[id].find(line) != mustRejected[id].end()){
-        mustRejected[id].erase(line);
+    if(!line.empty() && rawDataFromPortFile.takeRejected(entry, line))
+        return true;
+    /*Case the container can't be loaded here: it's not awaiting at the port (e.g. the last stop, where nothing is loaded)*/
+    if(std::get<0>(tup) < 0 && !isIdAwaitAtPort(id))
         return true;
-    }
     /*Case the container with this didn't prioritize by algorithm*/
     if(!line.empty() && priorityRejected.find(id) !=  priorityRejected.end())
         return true;
@@ -107,9 +159,11 @@ bool SimulatorValidation::validateRejectInstruction(string& id,int kg){
     /*Case there is no free space in the ship map*/
     if(ship->getFreeSpace() == 0)
         return true;
-    /*Case there is an weight balance problem*/
-    if(!checkIfBalanceWeightIssue(sim,kg,tup))
+    /*Case the container could be loaded, only a weight balance problem lets it be left at the port*/
+    if(checkIfBalanceWeightIssue(kg,tup)){
+        balanceRejected.insert(id);
         return true;
+    }
 
     return false;
 }
@@ -117,7 +171,7 @@ bool SimulatorValidation::validateRejectInstruction(string& id,int kg){
 /**
  * This function validates load crane instruction given by the algorithm
  */
-bool SimulatorValidation::validateLoadInstruction(vector<int> &coordinates,int kg,string& id){
+bool SimulatorValidation::validateLoadInstruction(const craneCoordinates &coordinates,int kg,string& id){
     int z = coordinates[0],x = coordinates[1], y = coordinates[2];
     auto &ship = sim->getShip();
     auto &map = ship->getMap();
@@ -131,16 +185,17 @@ bool SimulatorValidation::validateLoadInstruction(vector<int> &coordinates,int k
     if(priorityRejected.find(id) != priorityRejected.end())
         return false;
     /*Check if an error found while parsing the id*/
-    if(mustRejected.find(id) != mustRejected.end() && !isIdAwaitAtPort(id))
+    int entry = rawDataFromPortFile.find(id);
+    if(entry != CargoDataTable::npos && rawDataFromPortFile.hasRejected(entry) && !isIdAwaitAtPort(id))
         return false;
     /*Check if the weight balance is approved*/
-    return sim->getCalc().tryOperation('L', kg, x, y) == APPROVED;
+    return calc.tryOperation('L', kg, x, y) == APPROVED;
 }
 
 /**
  * This function validate's unload crane instruction. given by the algorithm
  */
-bool SimulatorValidation::validateUnloadInstruction(vector<int> &coordinates){
+bool SimulatorValidation::validateUnloadInstruction(const craneCoordinates &coordinates){
     int z = coordinates[0],x = coordinates[1], y = coordinates[2];
     auto &ship = sim->getShip();
     auto &map = ship->getMap();
@@ -156,7 +211,7 @@ bool SimulatorValidation::validateUnloadInstruction(vector<int> &coordinates){
         /*Check if weight balance is approved*/
     else {
         int kg = map.at(x).at(y).at(z).getWeight();
-        return sim->getCalc().tryOperation('U', kg, x, y) == APPROVED;
+        return calc.tryOperation('U', kg, x, y) == APPROVED;
     }
 }
 
@@ -165,7 +220,7 @@ bool SimulatorValidation::validateUnloadInstruction(vector<int> &coordinates){
  * This function checks if algorithm move crane instruction is valid, logically it checks if the unload operation
  * and the load operation of the move are legal
  */
-bool SimulatorValidation::validateMoveInstruction(vector<int> &coordinates){
+bool SimulatorValidation::validateMoveInstruction(const craneCoordinates &coordinates){
     int z1 = coordinates[0],x1 = coordinates[1],y1 = coordinates[2];
     int z2 = coordinates[3],x2 = coordinates[4],y2 = coordinates[5];
     int realX = sim->getShip()->getAxis("x"), realY = sim->getShip()->getAxis("y");
@@ -179,9 +234,15 @@ bool SimulatorValidation::validateMoveInstruction(vector<int> &coordinates){
     /*Check if the position of z axis is out of bounds*/
     if((int)(map.at(x1).at(y1).size()) != z1 + 1 || (int)(map.at(x2).at(y2).size()) != z2)
         return false;
-    /*Check if weight balance approved for unload && for load*/
+    /*Check if weight balance approved for unload && for load, the unload is undone if the load isn't approved*/
     kg = map.at(x1).at(y1).at(z1).getWeight();
-    return sim->getCalc().tryOperation('U', kg, x1, y1) == APPROVED && sim->getCalc().tryOperation('L', kg, x2, y2) == APPROVED;
+    size_t checkpoint = calc.checkpoint();
+    if(calc.tryOperation('U', kg, x1, y1) == APPROVED && calc.tryOperation('L', kg, x2, y2) == APPROVED){
+        calc.commit(checkpoint);
+        return true;
+    }
+    calc.rollback(checkpoint);
+    return false;
 }
 
 /**
@@ -189,96 +250,187 @@ bool SimulatorValidation::validateMoveInstruction(vector<int> &coordinates){
  * if coordinates(x,y,z) are != -1 then --> container is on ship so we want to unload this
  * else container is on port and we want to load it
  */
-bool SimulatorValidation::checkIfBalanceWeightIssue(SimulatorObj* sim, int kg,std::tuple<int,int,int> &coordinates){
+bool SimulatorValidation::checkIfBalanceWeightIssue(int kg,std::tuple<int,int,int> &coordinates){
     if(std::get<0>(coordinates) >= 0){
-        return sim->getCalc().tryOperation('U',kg,std::get<0>(coordinates),std::get<1>(coordinates)) != BalanceStatus::APPROVED;
+        return calc.probe('U',kg,std::get<0>(coordinates),std::get<1>(coordinates)) != BalanceStatus::APPROVED;
     }
-    else{
-        for(int i = 0; i < sim->getShip()->getAxis("x"); i++){
-            for(int j = 0; j < sim->getShip()->getAxis("y"); j++){
-                if((int)sim->getShip()->getMap()[i][j].size() < sim->getShip()->getAxis("z"))
-                    if(sim->getCalc().tryOperation('L',kg,i,j) == BalanceStatus::APPROVED)
-                        /*Found a position that the container can be loaded at*/
-                        return false;
+    /*Found a position that the container can be loaded at*/
+    return !hasApprovedColumn(kg);
+}
+
+/**
+ * This function answers if there's a non full column that the calculator approves loading kg to,
+ * the approved columns are a rectangle so it's a range count of the open columns, O(log X * log Y)
+ */
+bool SimulatorValidation::hasApprovedColumn(int kg){
+    BalanceRange approved = calc.approvedRange('L', kg);
+    return !approved.empty() && countOpenColumns(approved) > 0;
+}
+
+/**
+ * This function collects the columns of the ship map that are not full
+ */
+void SimulatorValidation::initOpenColumns(){
+    auto &ship = sim->getShip();
+    auto &shipMap = ship->getMap();
+    int maxHeight = ship->getAxis("z");
+    openColumnsX = (int)shipMap.size();
+    openColumnsY = openColumnsX > 0 ? (int)shipMap[0].size() : 0;
+    openColumns.assign(openColumnsX * openColumnsY, false);
+    openColumnsTree.assign((openColumnsX + 1) * (openColumnsY + 1), 0);
+    for(int x = 0; x < openColumnsX; x++)
+        for(int y = 0; y < openColumnsY; y++)
+            if((int)shipMap[x][y].size() < maxHeight){
+                openColumns[x * openColumnsY + y] = true;
+                addOpenColumn(x, y, 1);
             }
-        }
+}
+
+/**
+ * This function updates the open columns after the column (x,y) height changed
+ */
+void SimulatorValidation::updateOpenColumn(int x, int y){
+    if(x < 0 || x >= openColumnsX || y < 0 || y >= openColumnsY)
+        return;
+    auto &ship = sim->getShip();
+    bool open = (int)ship->getMap()[x][y].size() < ship->getAxis("z");
+    if(open != (bool)openColumns[x * openColumnsY + y]){
+        openColumns[x * openColumnsY + y] = open;
+        addOpenColumn(x, y, open ? 1 : -1);
     }
-    return true;
+}
+
+void SimulatorValidation::addOpenColumn(int x, int y, int delta){
+    for(int i = x + 1; i <= openColumnsX; i += i & -i)
+        for(int j = y + 1; j <= openColumnsY; j += j & -j)
+            openColumnsTree[i * (openColumnsY + 1) + j] += delta;
+}
+
+/**
+ * @return the number of open columns at [0, x) * [0, y)
+ */
+int SimulatorValidation::countOpenColumns(int x, int y){
+    int count = 0;
+    for(int i = std::min(x, openColumnsX); i > 0; i -= i & -i)
+        for(int j = std::min(y, openColumnsY); j > 0; j -= j & -j)
+            count += openColumnsTree[i * (openColumnsY + 1) + j];
+    return count;
+}
+
+/**
+ * @return the number of open columns at the given rectangle
+ */
+int SimulatorValidation::countOpenColumns(const BalanceRange& range){
+    if(range.approveAll)
+        return countOpenColumns(openColumnsX, openColumnsY);
+    int x1 = std::max(range.firstX, 0), x2 = range.lastX + 1, y1 = std::max(range.firstY, 0), y2 = range.lastY + 1;
+    if(x1 >= x2 || y1 >= y2)
+        return 0;
+    return countOpenColumns(x2, y2) - countOpenColumns(x1, y2) - countOpenColumns(x2, y1) + countOpenColumns(x1, y1);
 }
 
 /**
  * This function extracts the kg of a given id from possible existence of this id
  */
-int SimulatorValidation::extractKgToValidate(map<string,list<string>>& rawData,SimulatorObj* sim,string& id){
+int SimulatorValidation::extractKgToValidate(string& id){
     vector<string> parsedInfo;
-    int kg = -1;
-    bool found = false;
-
+    auto port = sim->getPort();
     /*First check if container exist in priority list*/
-    for(auto &cont : *(sim->getPort()->getContainerVec(Type::PRIORITY))){
-        if(cont.getId() == id){
-            kg = cont.getWeight();
-            found = true;
-        }
-    }
+    Container* awaiting = port->findContainer(id, Type::PRIORITY);
+    if(awaiting != nullptr)
+        return awaiting->getWeight();
     /*If not in priority list check in load list*/
-    if(!found){
-        for(auto &cont : *(sim->getPort()->getContainerVec(Type::LOAD))){
-            if(cont.getId() == id){
-                kg = cont.getWeight();
-                found = true;
-            }
-        }
-    }
+    awaiting = port->findContainer(id, Type::LOAD);
+    if(awaiting != nullptr)
+        return awaiting->getWeight();
     /*Check if container id exist in the container at port file*/
-    if(!found && rawData.find(id) != rawData.end()){
-        parsedInfo = stringSplit(rawData[id].front(),delim);
-        if(isValidInteger(parsedInfo.at(1))){
-            kg = atoi(parsedInfo.at(1).data());
-            found = true;
-        }
+    int entry = rawDataFromPortFile.find(id);
+    if(entry != CargoDataTable::npos && rawDataFromPortFile.size(entry) > 0){
+        parsedInfo = stringSplit(string(rawDataFromPortFile.front(entry)),delim);
+        if(parsedInfo.size() > 1 && isValidInteger(parsedInfo.at(1)))
+            return atoi(parsedInfo.at(1).data());
     }
     /*Check if container is on ship map --> case we extract kg to unload operation*/
-    if(!found){
-        for(auto &vX : (sim->getShip()->getMap()))
-            for(auto &vY : vX)
-                for(auto &cont : vY)
-                    if(cont.getId() == id){
-                        kg = cont.getWeight();
-                    }
+    auto location = shipIndex.find(id);
+    if(location != shipIndex.end()){
+        auto [x, y, z] = location->second;
+        return sim->getShip()->getMap()[x][y][z].getWeight();
     }
-    return kg;
+    return -1;
+}
+
+/**
+ * This function returns the location (x,y,z) of the given id on the simulator ship map, or (-1,-1,-1) if it's not on ship
+ */
+std::tuple<int,int,int> SimulatorValidation::getShipLocation(const string& id){
+    auto location = shipIndex.find(id);
+    if(location == shipIndex.end())
+        return std::tuple<int,int,int>(-1,-1,-1);
+    return location->second;
+}
+
+/**
+ * This function indexes the location of every container on the simulator ship map by it's id,
+ * it walks the ship once per port, afterwards execute keeps the index up to date
+ */
+void SimulatorValidation::initShipIndex(){
+    auto &shipMap = sim->getShip()->getMap();
+    shipIndex.clear();
+    for(int x = 0; x < (int)shipMap.size(); x++)
+        for(int y = 0; y < (int)shipMap[x].size(); y++)
+            for(int z = 0; z < (int)shipMap[x][y].size(); z++)
+                shipIndex.emplace(shipMap[x][y][z].getId(), std::tuple<int,int,int>(x,y,z)); /*first occurrence is kept*/
 }
 
 /**
- * This function extracts the port name of the the container id
+ * This function creates a container based on instruction
+ * @param id - the container id we wish to create object
+ * @param instruction - Load\Unload --> 'L'\'U'
+ * @param srcPortName - the source of the container
+ * @return container.
  */
-string SimulatorValidation::extractPortNameToValidate(map<string,list<string>>& rawData,SimulatorObj* sim,string& id){
+std::unique_ptr<Container> SimulatorValidation::createContainer(string& id, char instruction, string& srcPortName){
     vector<string> parsedInfo;
-    string portName;
-    if(rawData.find(id) != rawData.end()){
-        parsedInfo = stringSplit(rawData.find(id)->second.front(),delim);
-        portName = parsedInfo.at(2);
-    } else{
-        for(auto &cont : *(sim->getPort()->getContainerVec(Type::PRIORITY))){
-            if(cont.getId() == id){
-                portName = cont.getDest()->get_name();
-            }
+    std::unique_ptr<Container> cont;
+    auto &ship = sim->getShip();
+    if(instruction == 'L'){
+        auto srcPort = ship->getPortByName(srcPortName);
+        /*Case we load container exists in the raw Data*/
+        if(rawDataFromPortFile.contains(id)){
+            parsedInfo = stringSplit(string(rawDataFromPortFile.front(rawDataFromPortFile.find(id))), delim);
+            auto dstPort = ship->getPortByName(parsedInfo[2]);
+            int kg = atoi(parsedInfo[1].data());
+            cont = std::make_unique<Container>(id, kg, srcPort, dstPort);
+        }
+        /*Case we load container that unloaded before and now loaded*/
+        else {
+            Container* awaiting = sim->getPort()->findContainer(id, Type::PRIORITY);
+            if(awaiting != nullptr)
+                cont = std::make_unique<Container>(awaiting->getId(), awaiting->getWeight(), srcPort, awaiting->getDest());
         }
     }
-    return portName;
+    if(instruction == 'U'){
+        auto location = shipIndex.find(id);
+        if(location == shipIndex.end())
+            return nullptr;
+        auto [x, y, z] = location->second;
+        auto srcPort = ship->getPortByName(srcPortName);
+        auto &container = ship->getMap()[x][y][z];
+        cont = std::make_unique<Container>(container.getId(), container.getWeight(), srcPort, container.getDest());
+    }
+    return cont;
 }
 
 /**
  * This function checks if there were containers at port file that were not handled at all
  */
-int SimulatorValidation::checkContainersDidntHandle(map<string, list<string>> &idAndRawLine,list<string> &currAlgErrors,string &portName,int visitNum) {
+int SimulatorValidation::checkContainersDidntHandle(CargoDataTable &idAndRawLine,ErrorList &currAlgErrors,string &portName,int visitNum) {
     int err = 0;
-    for(auto& idInstruction : idAndRawLine){
-        if(!idInstruction.second.empty() && !softCheckId(idInstruction.first)){
-            for(auto &line : idInstruction.second){
-                currAlgErrors.emplace_back(ERROR_LINE_NOT_HANDLE(line, portName, visitNum));
-            }
+    for(int entry : idAndRawLine.sortedEntries()){
+        if(idAndRawLine.size(entry) > 0 && !softCheckId(string(idAndRawLine.id(entry)))){
+            idAndRawLine.forEachLine(entry, [&](int, std::string_view line){
+                currAlgErrors.add(ErrorCode::LineNotHandle, string(line), portName, string(), visitNum);
+            });
             err= -1;
         }
     }
@@ -289,8 +441,9 @@ int SimulatorValidation::checkContainersDidntHandle(map<string, list<string>> &i
  * This function checks if there were containers that unloaded at this port
  * that the destination of the container != current port
  * also checks if there is a free space at the ship and containers that didn't loaded
+ * (except the ones rejected because of the weight balance)
  */
-int SimulatorValidation::checkIfContainersLeftOnPort(SimulatorObj* sim , list<string> &currAlgErrors){
+int SimulatorValidation::checkIfContainersLeftOnPort(SimulatorObj* sim , ErrorList &currAlgErrors,const std::unordered_set<string> &balanceRejected){
     auto currPort = sim->getPort();
     string currPortName = currPort->get_name();
     int err = 0;
@@ -298,15 +451,17 @@ int SimulatorValidation::checkIfContainersLeftOnPort(SimulatorObj* sim , list<st
         err = -1;
         string id = cont.getId();
         string dstPortName = cont.getDest()->get_name();
-        currAlgErrors.emplace_back(ERROR_CONT_NOT_INDEST(id, currPortName, dstPortName));
+        currAlgErrors.add(ErrorCode::ContNotInDest, id, currPortName, dstPortName);
     }
     /*Case there is still space on ship*/
     if(sim->getShip()->getFreeSpace() > 0 && err != -1){
         for(auto& cont : *currPort->getContainerVec(Type::LOAD)){
-            err = -1;
             string id = cont.getId();
+            if(balanceRejected.count(id))
+                continue;
+            err = -1;
             string dstPortName = cont.getDest()->get_name();
-            currAlgErrors.emplace_back(ERROR_CONT_LEFT_ONPORT(id, currPortName, dstPortName));
+            currAlgErrors.add(ErrorCode::ContLeftOnPort, id, currPortName, dstPortName);
         }
     }
     return err;
@@ -317,17 +472,17 @@ int SimulatorValidation::checkIfContainersLeftOnPort(SimulatorObj* sim , list<st
  * at the end of this port stop we have containers left on ship map such that for container x
  * that left on ship it's destination is this port stop but it didnt unloaded.
  */
-int  SimulatorValidation::checkForContainersNotUnloaded(SimulatorObj* sim, list<string> &currAlgErrors){
+int  SimulatorValidation::checkForContainersNotUnloaded(SimulatorObj* sim, ErrorList &currAlgErrors){
     auto currPort = sim->getPort();
     int err = 0;
-    for(auto& cont : sim->getShip()->getContainersByPort()[currPort]){
-        currAlgErrors.emplace_back(ERROR_CONT_LEFT_ONSHIP(cont.getId()));
+    for(auto& cont : *sim->getShip()->getContainersByPort()[currPort].data()){
+        currAlgErrors.add(ErrorCode::ContLeftOnShip, cont.getId());
         err = -1;
     }
     return err;
 }
 
-int SimulatorValidation::checkIfContainerLeftOnShipFinalPort(SimulatorObj* sim,list<string> &currAlgErrors){
+int SimulatorValidation::checkIfContainerLeftOnShipFinalPort(SimulatorObj* sim,ErrorList &currAlgErrors){
     int err = 0;
     auto& shipMap = sim->getShip()->getMap();
     if(sim->getPortNum() != (int)sim->getShip()->getRoute().size() - 1)
@@ -337,7 +492,7 @@ int SimulatorValidation::checkIfContainerLeftOnShipFinalPort(SimulatorObj* sim,l
             for(auto& vY : vX)
                 for(auto& cont : vY) {
                     if(cont.getId() != "block"){
-                        currAlgErrors.emplace_back(ERROR_CONT_LEFT_LAST_PORT(cont.getId()));
+                        currAlgErrors.add(ErrorCode::ContLeftLastPort, cont.getId());
                         err = -1;
                     }
                 }
@@ -352,20 +507,18 @@ int SimulatorValidation::checkIfContainerLeftOnShipFinalPort(SimulatorObj* sim,l
 void SimulatorValidation::initLoadedListAndRejected() {
     auto &shipMap = sim->getShip();
     auto currPort = sim->getPort();
-    for (auto &outterPair : rawDataFromPortFile) {
+    string info;
+    for (int entry : rawDataFromPortFile.sortedEntries()) {
         bool alreadyFound = false;
-        for (auto &info : outterPair.second) {
+        rawDataFromPortFile.forEachLine(entry, [&](int lineIndex, std::string_view line){
             VALIDATION reason = VALIDATION::Valid;
             string id;
             int weight = -1;
             std::shared_ptr<Port> dest;
-            std::pair<string, VALIDATION> p;
-            vector<string> parsedInfo = stringSplit(info, delim);
-            validateContainerDataForReject(info, reason, sim);
+            info.assign(line);
+            validateContainerDataForReject(info, reason);
             if (reason != VALIDATION::Valid) {
-                p.first = info;
-                p.second = reason;
-                mustRejected[parsedInfo[0]].insert({info,reason});
+                rawDataFromPortFile.markRejected(entry, lineIndex);
                 alreadyFound = true;
             } else if(!alreadyFound) {
                 extractContainersData(info, id, weight, dest, shipMap);
@@ -373,10 +526,10 @@ void SimulatorValidation::initLoadedListAndRejected() {
                 currPort->addContainer(con, Type::LOAD);
             }
             else{
-                reason = VALIDATION::DuplicatedIdOnPort;
-                mustRejected[parsedInfo[0]].insert({info,reason});
+                /*reason --> VALIDATION::DuplicatedIdOnPort*/
+                rawDataFromPortFile.markRejected(entry, lineIndex);
             }
-        }
+        });
     }
 
 }
@@ -385,10 +538,8 @@ void SimulatorValidation::initLoadedListAndRejected() {
  * This function is a shallow validation for a given raw line from cargo_data port file and checks if it's valid
  * or not, if not it returns the reason for invalidation.
  */
-void SimulatorValidation::validateContainerDataForReject(string& line,VALIDATION &reason,SimulatorObj* sim){
+void SimulatorValidation::validateContainerDataForReject(const string& line,VALIDATION &reason){
     auto parsedInfo = stringSplit(line,delim);
-    auto& simShip = sim->getShip();
-    auto srcPort = sim->getPort();
     int portNum = sim->getPortNum();
     if(parsedInfo.size() != 3){
         reason = VALIDATION::InvalidNumParameters;
@@ -411,7 +562,7 @@ void SimulatorValidation::validateContainerDataForReject(string& line,VALIDATION
             reason = VALIDATION :: InvalidPort;
             return;
         }
-        else if(idExistOnShip(parsedInfo[0],simShip)){
+        else if(shipIndex.find(parsedInfo[0]) != shipIndex.end()){
             reason = VALIDATION :: ExistID;
             return;
         }
@@ -433,43 +584,39 @@ void SimulatorValidation::initPriorityRejected(){
     loadCapacity = simShip->getFreeSpace() + amountToUnload;
     if(loadCapacity < amountToLoad) {
         sim->sortContainersByPriority(currPortLoadVec);
-        for (int i = loadCapacity; i < amountToLoad; i++) {
-            string id = currPortLoadVec->at(i).getId();
-            priorityRejected.insert({id, currPortLoadVec->at(i)});
-        }
+        int firstRejected = std::max(loadCapacity, 0);
         /*This block handles the case that we have k containers that part of them were assigned rejected
          * and part of them were assigned as not rejected --> algorithm have the ability to choose randomly
-         * which to load and which to decline*/
+         * which to load and which to decline, the containers with the same destination are adjacent after sorting*/
         if (loadCapacity > 0) {
             string suffixPort = (*currPortLoadVec->at(loadCapacity).getDest()).get_name();
             string prevPort = (*currPortLoadVec->at(loadCapacity - 1).getDest()).get_name();
             if (prevPort == suffixPort) {
-                int i = 0;
-                while ((*currPortLoadVec->at(i).getDest()).get_name() != suffixPort) {
-                    i++;
-                }
-                while ((*currPortLoadVec->at(i).getDest()).get_name() == suffixPort) {
-                    string id = currPortLoadVec->at(i).getId();
-                    possiblePriorityReject.insert({id, currPortLoadVec->at(i)});
-                    if (priorityRejected.find(id) != priorityRejected.end()) {
-                        priorityRejected.erase(id);
-                    }
-                    i++;
-                }
+                int first = loadCapacity - 1;
+                while (first > 0 && (*currPortLoadVec->at(first - 1).getDest()).get_name() == suffixPort)
+                    first--;
+                firstRejected = loadCapacity + 1;
+                while (firstRejected < amountToLoad && (*currPortLoadVec->at(firstRejected).getDest()).get_name() == suffixPort)
+                    firstRejected++;
+                for (int i = first; i < firstRejected; i++)
+                    possiblePriorityReject.insert({currPortLoadVec->at(i).getId(), currPortLoadVec->at(i)});
             }
         }
+        for (int i = firstRejected; i < amountToLoad; i++) {
+            string id = currPortLoadVec->at(i).getId();
+            if (possiblePriorityReject.find(id) == possiblePriorityReject.end())
+                priorityRejected.insert({id, currPortLoadVec->at(i)});
+        }
     }
 }
 
 /**
- * This function erasing the given id and line from the raw data map
+ * This function erasing the last line of the given id from the raw data table
  */
-void SimulatorValidation::eraseFromRawData(string &line, string &id) {
-    if(line.empty()){}
-    if(rawDataFromPortFile[id].size() > 1)
-        rawDataFromPortFile[id].remove(rawDataFromPortFile[id].back());
-    else
-        rawDataFromPortFile.erase(id);
+void SimulatorValidation::eraseFromRawData(string &id) {
+    int entry = rawDataFromPortFile.find(id);
+    if(entry != CargoDataTable::npos && rawDataFromPortFile.size(entry) > 0)
+        rawDataFromPortFile.eraseBack(entry);
 }
 
 /**
@@ -479,13 +626,13 @@ void SimulatorValidation::eraseFromRawData(string &line, string &id) {
  * checks if there were containers that left on ship that was supposed to unloaded
  * checks if there were lines at cargo_data port file that were not hanlded at all
  */
-int SimulatorValidation::finalChecks(list<string> &currAlgErrors, string &portName, int visitNumber) {
+int SimulatorValidation::finalChecks(ErrorList &currAlgErrors, string &portName, int visitNumber) {
     int errorsCount = 0;
     auto currPortPriority = sim->getPort()->getContainerVec(Type::PRIORITY);
     sim->sortContainersByPriority(currPortPriority);
     if(checkPrioritizedHandledProperly(currAlgErrors) == -1)
         return -1;
-    else if(checkIfContainersLeftOnPort(sim,currAlgErrors) == -1)
+    else if(checkIfContainersLeftOnPort(sim,currAlgErrors,balanceRejected) == -1)
         return -1;
     else if(checkForContainersNotUnloaded(sim, currAlgErrors) == -1)
         return -1;
@@ -504,27 +651,36 @@ void SimulatorValidation::execute(char command, std::unique_ptr<Container>& cont
     string id;
     auto& ship = sim->getShip();
     auto port = sim->getPort();
+    auto& shipMap = ship->getMap();
+    int x1 = std::get<0>(origin), y1 = std::get<1>(origin);
     if(command == 'L'){
         id = container->getId();
         ship->addContainer(*container, origin);
         port->removeContainer(id,Type::LOAD);
         port->removeContainer(id,Type::PRIORITY);
+        shipIndex.insert_or_assign(id, std::tuple<int,int,int>(x1, y1, (int)shipMap[x1][y1].size() - 1));
     }
     else if(command == 'U'){
         if((container->getDest()->get_name() == port->get_name()))
             port->addContainer(*container, Type::ARRIVED);
         else
             port->addContainer(*container, Type::PRIORITY);
+        shipIndex.erase(shipMap[x1][y1].back().getId());
         ship->removeContainer(origin);
     }
-    else
+    else {
+        int x2 = std::get<0>(dest), y2 = std::get<1>(dest);
         ship->moveContainer(origin, dest);
+        shipIndex.insert_or_assign(shipMap[x2][y2].back().getId(), std::tuple<int,int,int>(x2, y2, (int)shipMap[x2][y2].size() - 1));
+        updateOpenColumn(x2, y2);
+    }
+    updateOpenColumn(x1, y1);
 }
 
 /**
  * This function checks that enough prioritized containers loaded from this port
  */
-int SimulatorValidation::checkPrioritizedHandledProperly(list<string> &currAlgErrors) {
+int SimulatorValidation::checkPrioritizedHandledProperly(ErrorList &currAlgErrors) {
     auto& simShip = sim->getShip();
     int err = 0;
     std::shared_ptr<Port> port;
@@ -533,7 +689,7 @@ int SimulatorValidation::checkPrioritizedHandledProperly(list<string> &currAlgEr
             port = pair.second.getDest();
             break;
         }
-        auto &contOnShipByPort = simShip->getContainersByPort()[port];
+        auto &contOnShipByPort = *simShip->getContainersByPort()[port].data();
         for(auto& pair : possiblePriorityReject){
             for(int i = 0; i < (int)contOnShipByPort.size(); i++){
                 if(contOnShipByPort.at(i).getId() == pair.second.getId() && loadCapacity > 0){
@@ -542,7 +698,7 @@ int SimulatorValidation::checkPrioritizedHandledProperly(list<string> &currAlgEr
             }
         }
         if(loadCapacity > 0){
-            currAlgErrors.emplace_back(ERROR_LEFT_PRIORITY_ONPORT);
+            currAlgErrors.add(ErrorCode::LeftPriorityOnPort);
             err = -1;
         }
     }
@@ -563,15 +719,6 @@ bool SimulatorValidation::softCheckId(string id){
  * This function checks if a given id await at port priorirty vector or load vector
  */
 bool SimulatorValidation::isIdAwaitAtPort(string& id){
-    for(auto& cont : *sim->getPort()->getContainerVec(Type::PRIORITY))
-        if(id == cont.getId())
-            return true;
-    for(auto& cont : *sim->getPort()->getContainerVec(Type::LOAD))
-        if(id == cont.getId())
-            return true;
-    return false;
+    auto port = sim->getPort();
+    return port->findContainer(id, Type::PRIORITY) != nullptr || port->findContainer(id, Type::LOAD) != nullptr;
 }
-
-
-
-
@@ -4,6 +4,7 @@
 *      *******      Functions      *******
 * validateAlgorithm                 - main function to validate algorithm crane instructions
 * validateInstruction               - managing the instructions validation
+* checkInstructionStructure         - lightweight check that the crane can perform the instruction on the ship map
 * validateLoadInstruction           - validates the load instruction
 * validateUnloadInstruction         - validates the unload instruction
 * validateMoveInstruction           - validates the move instruction
@@ -14,54 +15,83 @@
 * eraseFromRawData                  - erasing from raw data given id
 * finalChecks                       - managing the final checks
 * checkIfBalanceWeightIssue         - checks if there's weight balance issue
+* hasApprovedColumn                 - checks if there's a non full column approved for loading the given weight
+* initOpenColumns                   - collects the non full columns of the ship map
+* updateOpenColumn                  - updates the non full columns after a column changed
+* addOpenColumn                     - adds to the count of non full columns at a column
+* countOpenColumns                  - counts the non full columns at a prefix / a rectangle of the ship map
 * checkForContainersNotUnloaded     - checks if there's a container that didn't unloaded
 * checkContainersDidntHandle        - checks if there are containers at cargo_data that alg didn't handle at all
 * checkIfContainersLeftOnPort       - checks if there were container left on port
 * checkIfContainerLeftOnShipFinalPort   - checks if there were containers left on ship final port
 * checkPrioritizedHandledProperly       - checks if algorithm prioritized correctly
 * extractKgToValidate                   - extracts the kg to validate
-* extractPortNameToValidate             - extracts the port name to validate
 * execute                               - executes the L/M/U instructions on simulator ship map
 * softCheckId                           - soft checks id's that possibly didn't handled by algorithm
-* isIdAwaitAtPort                       - checks if the given id await at port
+* isIdAwaitAtPort                       - checks if the given id await at port (by the port's id indexed queues)
+* createContainer                       - creates container by searching it's id in the data
+* getShipLocation                       - gets the location of the given id on the ship map
+* initShipIndex                         - indexes the ship map containers by id
  */
 #ifndef SIMULATORVALIDATION_H
 #define SIMULATORVALIDATION_H
 
 enum class VALIDATION;
 #include "SimulatorObj.h"
+#include "../common/CraneInstruction.h"
+#include "ErrorRecord.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <set>
 
 class SimulatorValidation{
-    map<string,list<string>> rawDataFromPortFile;
-    map<string,map<string,VALIDATION>> mustRejected;
+    CargoDataTable &rawDataFromPortFile; /*shared by the simulator, also holds the lines that must be rejected*/
     map<string,Container> priorityRejected;
     map<string,Container> possiblePriorityReject;
+    std::unordered_set<string> balanceRejected; /*ids whose reject was accepted because of the weight balance*/
+    /*per port index of the ship map by container id, kept up to date by execute (the port's lists are indexed by Port)*/
+    std::unordered_map<string,std::tuple<int,int,int>> shipIndex;
+    /*non full columns of the ship map, flags and a 2D Fenwick tree counting them (index x * Y + y), kept up to date by execute*/
+    std::vector<unsigned char> openColumns;
+    std::vector<int> openColumnsTree;
+    int openColumnsX = 0, openColumnsY = 0;
     SimulatorObj* sim = nullptr;
+    WeightBalanceCalculator &calc; /*the simulator's calculator of the current run, shared by all the ports*/
     int loadCapacity = 0;
 public:
-    explicit SimulatorValidation(SimulatorObj* simToCopy):sim(simToCopy){};
-    std::optional<pair<int,int>> validateAlgorithm(string &outputPath, string &contAtPortPath,list<string>& currAlgErrors,string& portName,int visitNumber);
-    bool validateInstruction(string &instruction,string &id,vector<int> &coordinates);
-    bool validateLoadInstruction(vector<int> &coordinates,int kg,string& id);
-    bool validateUnloadInstruction(vector<int> &coordinates);
-    bool validateMoveInstruction(vector<int> &coordinates);
+    explicit SimulatorValidation(SimulatorObj* simToCopy);
+    std::optional<pair<int,int>> validateAlgorithm(string &outputPath, string &contAtPortPath, const std::optional<string> &contAtPortData,ErrorList& currAlgErrors,string& portName,int visitNumber,
+                                                   bool fullValidation = true);
+    bool validateInstruction(const CraneInstruction &instruction,string &id);
+    bool checkInstructionStructure(const CraneInstruction &instruction,string &id);
+    bool validateLoadInstruction(const craneCoordinates &coordinates,int kg,string& id);
+    bool validateUnloadInstruction(const craneCoordinates &coordinates);
+    bool validateMoveInstruction(const craneCoordinates &coordinates);
     bool validateRejectInstruction(string& id,int kg);
     void initPriorityRejected();
     void initLoadedListAndRejected();
-    void eraseFromRawData(string& line,string& id);
-    int finalChecks(list<string> &currAlgErrors,string& portName, int visitNumber);
-    int checkPrioritizedHandledProperly(list<string> &currAlgErrors);
-    static bool checkIfBalanceWeightIssue(SimulatorObj* sim, int kg,std::tuple<int,int,int>& coordinates);
-    static int checkForContainersNotUnloaded(SimulatorObj* sim, list<string> &currAlgErrors);
-    static int checkContainersDidntHandle(map<string, list<string>> &idAndRawLine,list<string> &currAlgErrors,string& portName, int visitNum);
-    static int checkIfContainersLeftOnPort(SimulatorObj* sim , list<string> &currAlgErrors);
-    static int checkIfContainerLeftOnShipFinalPort(SimulatorObj* sim,list<string> &currAlgErrors);
-    static int extractKgToValidate(map<string,list<string>>& rawData,SimulatorObj* sim,string& id);
-    static string extractPortNameToValidate(map<string,list<string>>& rawData,SimulatorObj* sim,string& id);
-    static void validateContainerDataForReject(string& line,VALIDATION &reason,SimulatorObj* sim);
+    void eraseFromRawData(string& id);
+    int finalChecks(ErrorList &currAlgErrors,string& portName, int visitNumber);
+    int checkPrioritizedHandledProperly(ErrorList &currAlgErrors);
+    bool checkIfBalanceWeightIssue(int kg,std::tuple<int,int,int>& coordinates);
+    bool hasApprovedColumn(int kg);
+    void initOpenColumns();
+    void updateOpenColumn(int x, int y);
+    void addOpenColumn(int x, int y, int delta);
+    int countOpenColumns(int x, int y);
+    int countOpenColumns(const BalanceRange& range);
+    static int checkForContainersNotUnloaded(SimulatorObj* sim, ErrorList &currAlgErrors);
+    static int checkContainersDidntHandle(CargoDataTable &idAndRawLine,ErrorList &currAlgErrors,string& portName, int visitNum);
+    static int checkIfContainersLeftOnPort(SimulatorObj* sim , ErrorList &currAlgErrors,const std::unordered_set<string> &balanceRejected);
+    static int checkIfContainerLeftOnShipFinalPort(SimulatorObj* sim,ErrorList &currAlgErrors);
+    int extractKgToValidate(string& id);
+    void validateContainerDataForReject(const string& line,VALIDATION &reason);
     static bool softCheckId(string id);
     void execute(char command,std::unique_ptr<Container>& container, coordinate origin, coordinate dest);
     bool isIdAwaitAtPort(string &id);
+    std::unique_ptr<Container> createContainer(string& id, char instruction, string& srcPortName);
+    std::tuple<int,int,int> getShipLocation(const string& id);
+    void initShipIndex();
 };
 
 
@@ -1,4 +1,7 @@
 #include "Travel.h"
+#include "../common/Ship.h"
+
+Travel::~Travel() = default;
 
 const string& Travel::getName() {
     return this->name;
@@ -28,7 +31,7 @@ map<string,vector<fs::path>>& Travel::getMap(){
     return this->portPaths;
 }
 
-map<string,list<string>>& Travel::getErrorsMap() {
+map<string,ErrorList>& Travel::getErrorsMap() {
     return this->errors;
 }
 
@@ -54,19 +57,31 @@ bool Travel::isErrorsExists() {
         return true;
     }
     for(auto& pair : this->errors){
-        for(auto& msg : pair.second){
-            if(msg.empty()){}
+        if(!pair.second.empty())
             return true;
-        }
     }
     return false;
 }
 
 void Travel::setAlgCrashError(string &algName){
-    list<string> lst;
-    lst.emplace_back(ERROR_ALG_PLAN);
+    ErrorList lst;
+    lst.add(ErrorCode::AlgPlan);
     this->errors.insert({algName,lst});
     this->algorithmsResults.insert({algName, {0, -1}});
 }
 
+void Travel::setShip(std::unique_ptr<Ship> travelShip){
+    this->ship = std::move(travelShip);
+}
+
+std::unique_ptr<Ship>& Travel::getShip(){
+    return this->ship;
+}
 
+void Travel::setSimErrorCodes(int codes){
+    this->simErrorCodes = codes;
+}
+
+int Travel::getSimErrorCodes(){
+    return this->simErrorCodes;
+}
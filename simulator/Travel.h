@@ -5,6 +5,7 @@
 * This header is a container of a Travel folder that holds the list of port paths , route path
 * plan path, errors found in this travel by simulator
 * and the algorithm results
+* also the ship parsed by the simulator from the plan and route files and the simulator error codes found while parsing
 *
 */
 
@@ -16,7 +17,9 @@
 #include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include "../interfaces/ErrorsInterface.h"
+#include "ErrorRecord.h"
 
 using std::cout;
 using std::endl;
@@ -27,6 +30,8 @@ using std::pair;
 using std::map;
 namespace fs = std::filesystem;
 
+class Ship;
+
 class Travel {
 
     string name;
@@ -34,19 +39,22 @@ class Travel {
     fs::path planPath;
     list<string> generalErrors;
     map<string,vector<fs::path>> portPaths;
-    map<string,list<string>> errors;
+    map<string,ErrorList> errors;
     map<string,pair<int,int>> algorithmsResults; /*first int --> instructions count, second int --> errors count*/
     bool erroneousTravel = false;
+    std::unique_ptr<Ship> ship;
+    int simErrorCodes = 0;
 
 public:
     explicit Travel(const string travelName):name(travelName){};
+    ~Travel();
     void setRoutePath(const fs::path& route);
     void setPlanPath(const fs::path& plan);
     void setNewGeneralError(const string& msg);
     void setErroneousTravel();
     const string& getName();
     map<string,vector<fs::path>>& getMap();
-    map<string,list<string>>& getErrorsMap();
+    map<string,ErrorList>& getErrorsMap();
     map<string,pair<int,int>>& getAlgResultsMap();
     list<string>& getGeneralErrors();
     fs::path& getRoutePath();
@@ -54,6 +62,10 @@ public:
     bool isErroneous();
     bool isErrorsExists();
     void setAlgCrashError(string &algName);
+    void setShip(std::unique_ptr<Ship> travelShip);
+    std::unique_ptr<Ship>& getShip();
+    void setSimErrorCodes(int codes);
+    int getSimErrorCodes();
 };
 
 
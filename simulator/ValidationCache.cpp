@@ -0,0 +1,230 @@
+#include "ValidationCache.h"
+#include "../common/Ship.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+    const uint64_t fnvOffset = 1469598103934665603ULL;
+    const uint64_t fnvPrime = 1099511628211ULL;
+
+    /*FNV-1a*/
+    uint64_t hashBytes(const char* data, size_t size, uint64_t seed){
+        for(size_t i = 0; i < size; i++){
+            seed ^= (unsigned char)data[i];
+            seed *= fnvPrime;
+        }
+        return seed;
+    }
+
+    uint64_t hashString(const string& str, uint64_t seed){
+        seed = hashBytes(str.data(), str.size(), seed);
+        return hashBytes("\0", 1, seed); /*separator, so "ab"+"c" != "a"+"bc"*/
+    }
+
+    bool readString(std::ifstream& file, string& str){
+        size_t length = 0;
+        if(!(file >> length) || file.get() != '\n')
+            return false;
+        str.assign(length, '\0');
+        return (bool)file.read(str.data(), (std::streamsize)length);
+    }
+
+    void writeString(std::ofstream& file, const string& str){
+        file << str.size() << '\n' << str << '\n';
+    }
+}
+
+/**
+ * opens (creates if needed) the cache folder and indexes the entries already in it
+ */
+ValidationCache::ValidationCache(const fs::path& cacheDir, map<string,fs::path> algorithmBinaries, size_t maxEntries, uintmax_t maxBytes)
+    : cacheDir(cacheDir), algorithmBinaries(std::move(algorithmBinaries)), maxEntries(maxEntries), maxBytes(maxBytes) {
+    std::error_code err;
+    fs::create_directories(cacheDir, err);
+    if(!fs::is_directory(cacheDir, err))
+        return;
+    for(const auto& file : fs::directory_iterator(cacheDir, err)){
+        if(file.path().extension() != ".entry")
+            continue;
+        EntryInfo info{file.file_size(err), file.last_write_time(err)};
+        entries.insert({file.path().stem().string(), info});
+        totalBytes += info.size;
+    }
+}
+
+fs::path ValidationCache::entryPath(const string& key) const {
+    return cacheDir / (key + ".entry");
+}
+
+/**
+ * hashes the content of the file at path (a missing file hashes as a marker) chained to seed
+ */
+uint64_t ValidationCache::hashFile(const fs::path& path, uint64_t seed){
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if(!file.is_open())
+        return hashString("<missing>", seed);
+    char buffer[1 << 16];
+    while(file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        seed = hashBytes(buffer, (size_t)file.gcount(), seed);
+    return hashBytes("\0", 1, seed);
+}
+
+/**
+ * hashes the plan, route and cargo_data files (names and contents) of the travel, once per travel.
+ * an empty cargo_data file is skipped (it's name holds the port, so the port isn't hashed on it's own): the simulator
+ * runs a visit without a file as an empty one and creates the empty file for it, so both have to hash the same for
+ * the next run to hit the cache.
+ */
+uint64_t ValidationCache::travelHash(std::unique_ptr<Travel>& travel){
+    auto cached = travelHashes.find(travel->getName());
+    if(cached != travelHashes.end())
+        return cached->second;
+    uint64_t hash = hashString(travel->getName(), fnvOffset);
+    hash = hashFile(travel->getPlanPath(), hash);
+    hash = hashFile(travel->getRoutePath(), hash);
+    for(auto& port : travel->getMap()){
+        for(auto& cargoFile : port.second){
+            std::error_code err;
+            if(cargoFile.empty() || (fs::file_size(cargoFile, err) == 0 && !err))
+                continue;
+            hash = hashString(cargoFile.filename().string(), hash);
+            hash = hashFile(cargoFile, hash);
+        }
+    }
+    travelHashes.insert({travel->getName(), hash});
+    return hash;
+}
+
+/**
+ * @param errorCodes - the simulator and algorithm error codes when the run starts, they affect the reported errors
+ * @return the key of running algName over travel
+ */
+string ValidationCache::makeKey(const string& algName, std::unique_ptr<Travel>& travel, const string& errorCodes){
+    auto binaryHash = binaryHashes.find(algName);
+    if(binaryHash == binaryHashes.end()){
+        auto binary = algorithmBinaries.find(algName);
+        uint64_t hash = hashString(algName, fnvOffset);
+        hash = binary == algorithmBinaries.end() ? hash : hashFile(binary->second, hash);
+        binaryHash = binaryHashes.insert({algName, hash}).first;
+    }
+    uint64_t hash = hashString(std::to_string(VALIDATION_CACHE_VERSION), fnvOffset);
+    hash = hashBytes((const char*)&binaryHash->second, sizeof(uint64_t), hash);
+    uint64_t travelKey = travelHash(travel);
+    hash = hashBytes((const char*)&travelKey, sizeof(uint64_t), hash);
+    hash = hashString(errorCodes, hash);
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+/**
+ * entry file format:
+ * <1 if results exist else 0> <instructions count> <errors count> <number of error records> <errors cap per code>
+ * <counter of every error code>
+ * then for every error record: <code> <number> <action>\n and it's x, y, z strings each as <length>\n<string>\n
+ * @return the entry, or nullopt if there's no such entry or it can't be read
+ */
+std::optional<ValidationCache::Entry> ValidationCache::lookup(const string& key){
+    auto info = entries.find(key);
+    if(info == entries.end())
+        return std::nullopt;
+    std::ifstream file(entryPath(key), std::ios::in | std::ios::binary);
+    int hasResults = 0, instructions = 0, errorsCount = 0, numOfErrors = 0;
+    size_t cap = 0;
+    std::array<size_t,NUM_OF_ERROR_CODES> counters{};
+    if(!(file >> hasResults >> instructions >> errorsCount >> numOfErrors >> cap))
+        return std::nullopt;
+    for(auto& counter : counters)
+        if(!(file >> counter))
+            return std::nullopt;
+    Entry entry{std::nullopt, ErrorList(cap)};
+    if(hasResults)
+        entry.results = pair<int,int>(instructions, errorsCount);
+    for(int i = 0; i < numOfErrors; i++){
+        int code = 0, action = 0;
+        ErrorRecord record;
+        if(!(file >> code >> record.number >> action) || file.get() != '\n' || code < 0 || code >= (int)NUM_OF_ERROR_CODES)
+            return std::nullopt;
+        if(!readString(file, record.x) || !readString(file, record.y) || !readString(file, record.z))
+            return std::nullopt;
+        record.code = (ErrorCode)code;
+        record.action = (char)action;
+        entry.errors.add(std::move(record));
+    }
+    for(size_t code = 0; code < NUM_OF_ERROR_CODES; code++)
+        entry.errors.setCount((ErrorCode)code, counters[code]);
+    /*Mark as recently used*/
+    std::error_code err;
+    info->second.lastUsed = fs::file_time_type::clock::now();
+    fs::last_write_time(entryPath(key), info->second.lastUsed, err);
+    return entry;
+}
+
+/**
+ * stores the entry, written to a temporary file first so a crash never leaves a partial entry
+ */
+void ValidationCache::store(const string& key, const Entry& entry){
+    std::error_code err;
+    fs::path path = entryPath(key), tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::out | std::ios::trunc | std::ios::binary);
+        if(!file.is_open())
+            return;
+        file << (entry.results ? 1 : 0) << ' ' << (entry.results ? entry.results->first : 0) << ' '
+             << (entry.results ? entry.results->second : 0) << ' ' << entry.errors.getRecords().size() << ' '
+             << entry.errors.getCap() << '\n';
+        for(size_t code = 0; code < NUM_OF_ERROR_CODES; code++)
+            file << entry.errors.count((ErrorCode)code) << (code + 1 < NUM_OF_ERROR_CODES ? ' ' : '\n');
+        for(auto& record : entry.errors.getRecords()){
+            file << (int)record.code << ' ' << record.number << ' ' << (int)record.action << '\n';
+            writeString(file, record.x);
+            writeString(file, record.y);
+            writeString(file, record.z);
+        }
+        if(!file)
+            return;
+    }
+    fs::rename(tmpPath, path, err);
+    if(err)
+        return;
+    auto old = entries.find(key);
+    if(old != entries.end())
+        totalBytes -= old->second.size;
+    EntryInfo info{fs::file_size(path, err), fs::file_time_type::clock::now()};
+    entries.insert_or_assign(key, info);
+    totalBytes += info.size;
+    evict();
+}
+
+/**
+ * removes the least recently used entries until the cache is within it's limits
+ */
+void ValidationCache::evict(){
+    if(entries.size() <= maxEntries && totalBytes <= maxBytes)
+        return;
+    vector<pair<fs::file_time_type,string>> byAge;
+    for(auto& entry : entries)
+        byAge.emplace_back(entry.second.lastUsed, entry.first);
+    std::sort(byAge.begin(), byAge.end());
+    std::error_code err;
+    for(auto& oldest : byAge){
+        if(entries.size() <= maxEntries && totalBytes <= maxBytes)
+            break;
+        fs::remove(entryPath(oldest.second), err);
+        totalBytes -= entries[oldest.second].size;
+        entries.erase(oldest.second);
+    }
+}
+
+/**
+ * removes all entries of the cache
+ */
+void ValidationCache::clear(){
+    std::error_code err;
+    for(auto& entry : entries)
+        fs::remove(entryPath(entry.first), err);
+    entries.clear();
+    totalBytes = 0;
+}
@@ -0,0 +1,73 @@
+#ifndef VALIDATION_CACHE_H
+#define VALIDATION_CACHE_H
+/**
+* This header is a persistent on disk cache of the simulator results of running an algorithm over a travel.
+* an entry is keyed by a content hash of the travel plan, route and cargo_data files, the algorithm .so file,
+* the error codes the simulator and the algorithm had when the run started, and the simulator settings that change
+* the validation (errors cap, sample rate, balance thresholds), so an entry is reused only when
+* running again would give the same result, then both the algorithm run and the validation are skipped.
+* every entry is a file <key>.entry at the cache folder holding the results pair and the error records of the run.
+* -invalidation:
+*   # VALIDATION_CACHE_VERSION is part of the key, bump it whenever the validation rules change.
+*   # clear removes all the entries (-clear_cache).
+* -limits: the least recently used entries are removed once there are more than maxEntries entries
+*  or their total size is more than maxBytes.
+*
+*      *******      Functions      *******
+* makeKey       - computes the key of running the given algorithm over the given travel
+* lookup        - gets the entry of the given key, if exists
+* store         - stores an entry with the given key
+* clear         - removes all entries
+* hashFile      - hashes the content of a file
+ */
+
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <filesystem>
+#include "Travel.h"
+#include "ErrorRecord.h"
+
+#define VALIDATION_CACHE_VERSION 4
+#define DEFAULT_CACHE_MAX_ENTRIES 10000
+#define DEFAULT_CACHE_MAX_MB 256
+
+class ValidationCache {
+public:
+    struct Entry {
+        std::optional<pair<int,int>> results; /*nullopt --> the algorithm had no results on this travel*/
+        ErrorList errors;
+    };
+
+private:
+    struct EntryInfo {
+        uintmax_t size;
+        fs::file_time_type lastUsed;
+    };
+    fs::path cacheDir;
+    map<string,fs::path> algorithmBinaries;
+    size_t maxEntries;
+    uintmax_t maxBytes;
+    map<string,EntryInfo> entries;
+    uintmax_t totalBytes = 0;
+    map<string,uint64_t> travelHashes;
+    map<string,uint64_t> binaryHashes;
+
+    fs::path entryPath(const string& key) const;
+    uint64_t travelHash(std::unique_ptr<Travel>& travel);
+    void evict();
+
+public:
+    ValidationCache(const fs::path& cacheDir, map<string,fs::path> algorithmBinaries,
+                    size_t maxEntries = DEFAULT_CACHE_MAX_ENTRIES, uintmax_t maxBytes = (uintmax_t)DEFAULT_CACHE_MAX_MB << 20);
+    string makeKey(const string& algName, std::unique_ptr<Travel>& travel, const string& errorCodes);
+    std::optional<Entry> lookup(const string& key);
+    void store(const string& key, const Entry& entry);
+    void clear();
+    static uint64_t hashFile(const fs::path& path, uint64_t seed);
+};
+
+#endif
@@ -13,8 +13,26 @@
  * 1. first will be shown the algorithm with the lowest errors occurred(generated by the simulator).
  * 2. second will be compared only iff 2 algorithms errors count is same the it will be sorted by number of instructions.
   Note - if no output path given -> output files will be at the directory the main program runs from.
+  Note - given -stream_window N the travels are loaded N at a time and freed once done, their errors are written
+  to Simulation.errors as soon as they finish, so memory stays flat for any number of travels.
+  Note - given -validate_only the algorithms are not run, the <alg>_<travel>_crane_instructions folders already at
+  the output path are validated again against the travels, and Simulation.results and Simulation.errors are rebuilt.
+  Note - given -cache_dir path every algorithm over travel run is cached at path, keyed by the content of the travel
+  files and the algorithm .so file, the next runs reuse it instead of running the algorithm and the validation
+  (the crane instructions of a cached run are not written again). -cache_max_entries N and -cache_max_mb N limit
+  the cache size, -clear_cache empties it before running.
+  Note - given -max_errors_per_code N only the first N errors of each error type are kept for every algorithm at every
+  travel, the rest are only counted and summarized by a single line at Simulation.errors.
+  Note - given -sampled_validation alg1:N1,alg2:N2 the given algorithms (trusted ones) are fully validated only at 1 out of
+  every N port visits, at the last visit and whenever the error codes they return change, the other visits only check
+  the instructions can be performed by the crane. Simulation.results then shows the validation policy of every algorithm.
+  Note - given -balance_threshold X,Y the weight balance calculators of the simulator and the algorithms decline
+  operations that move the ship's center of mass more than X (Y) columns away from the ship center on the x (y) axis.
+  Note - given -pipeline every port is validated on a second thread while the algorithm works on the next port,
+  the results are the same as without it.
  */
 #include <string>
+#include <cmath>
 #include "../common/Ship.h"
 #include "../common/Parser.h"
 #include "AlgorithmFactoryRegistrar.h"
@@ -26,6 +44,18 @@
 string mainTravelPath;
 string mainAlgorithmsPath;
 string mainOutputPath;
+int mainNumThreads = 0;
+int mainStreamWindow = 0;
+bool mainValidateOnly = false;
+string mainCachePath;
+int mainCacheMaxEntries = DEFAULT_CACHE_MAX_ENTRIES;
+int mainCacheMaxMb = DEFAULT_CACHE_MAX_MB;
+bool mainClearCache = false;
+bool mainPipeline = false;
+double mainBalanceX = NO_BALANCE_LIMIT;
+double mainBalanceY = NO_BALANCE_LIMIT;
+int mainMaxErrorsPerCode = 0;
+std::map<string,int> mainSampledValidation;
 
 /*-----------------------------Utility Functions-------------------------*/
 
@@ -49,6 +79,44 @@ vector<pair<string,std::unique_ptr<AbstractAlgorithm>>> initAlgorithmList(map<st
 //    return algList;
 //}
 
+/**
+ * This function parses the -sampled_validation value alg1:N1,alg2:N2 into mainSampledValidation
+ */
+void initSampledValidation(const string &policies){
+    for(auto &policy : stringSplit(policies, ",")){
+        auto separator = policy.rfind(':');
+        if(separator == string::npos || !isValidInteger(policy.substr(separator + 1))){
+            P_INVALID_SAMPLED_POLICY(policy)
+            continue;
+        }
+        mainSampledValidation[policy.substr(0, separator)] = atoi(policy.substr(separator + 1).data());
+    }
+}
+
+/**
+ * This function parses the -balance_threshold value X,Y (or a single value for both axes),
+ * every value has to be a non negative number and nothing else, otherwise the thresholds are left NO_BALANCE_LIMIT
+ */
+void initBalanceThresholds(const string &thresholds){
+    vector<double> parsed;
+    if(!thresholds.empty()){
+        for(auto &value : stringSplit(thresholds, ",")){
+            char *end = nullptr;
+            double threshold = std::strtod(value.data(), &end);
+            if(end == value.data() || *end != '\0' || !std::isfinite(threshold) || threshold < 0)
+                break;
+            parsed.push_back(threshold);
+        }
+    }
+    size_t numOfValues = thresholds.empty() ? 0 : std::count(thresholds.begin(), thresholds.end(), ',') + 1;
+    if(parsed.empty() || parsed.size() != numOfValues || parsed.size() > 2){
+        P_INVALID_BALANCE_THRESHOLD(thresholds)
+        return;
+    }
+    mainBalanceX = parsed[0];
+    mainBalanceY = parsed.size() == 2 ? parsed[1] : mainBalanceX;
+}
+
 /**
  * This function gets the paths or sets them to be the current working directory
  * @param argc
@@ -59,7 +127,26 @@ void initPaths(int argc,char** argv){
     const string travelFlag = "-travel_path";
     const string outputFlag = "-output";
     const string algorithmFlag = "-algorithm_path";
+    const string threadsFlag = "-num_threads";
+    const string streamFlag = "-stream_window";
+    const string validateOnlyFlag = "-validate_only";
+    const string cacheFlag = "-cache_dir";
+    const string cacheEntriesFlag = "-cache_max_entries";
+    const string cacheMbFlag = "-cache_max_mb";
+    const string clearCacheFlag = "-clear_cache";
+    const string pipelineFlag = "-pipeline";
+    const string balanceFlag = "-balance_threshold";
+    const string maxErrorsFlag = "-max_errors_per_code";
+    const string sampledFlag = "-sampled_validation";
 
+    for(int i = 1; i < argc; i++){
+        if(argv[i] == validateOnlyFlag)
+            mainValidateOnly = true;
+        else if(argv[i] == clearCacheFlag)
+            mainClearCache = true;
+        else if(argv[i] == pipelineFlag)
+            mainPipeline = true;
+    }
     for(int i = 1; i+1 < argc; i++){
         if(argv[i] == travelFlag)
             mainTravelPath = argv[i+1];
@@ -67,11 +154,29 @@ void initPaths(int argc,char** argv){
             mainOutputPath = argv[i+1];
         else if(argv[i] == algorithmFlag)
             mainAlgorithmsPath = argv[i+1];
+        else if(argv[i] == threadsFlag && isValidInteger(argv[i+1]))
+            mainNumThreads = atoi(argv[i+1]);
+        else if(argv[i] == streamFlag && isValidInteger(argv[i+1]))
+            mainStreamWindow = atoi(argv[i+1]);
+        else if(argv[i] == cacheFlag)
+            mainCachePath = argv[i+1];
+        else if(argv[i] == cacheEntriesFlag && isValidInteger(argv[i+1]))
+            mainCacheMaxEntries = atoi(argv[i+1]);
+        else if(argv[i] == cacheMbFlag && isValidInteger(argv[i+1]))
+            mainCacheMaxMb = atoi(argv[i+1]);
+        else if(argv[i] == maxErrorsFlag && isValidInteger(argv[i+1]))
+            mainMaxErrorsPerCode = atoi(argv[i+1]);
+        else if(argv[i] == sampledFlag)
+            initSampledValidation(argv[i+1]);
+        else if(argv[i] == balanceFlag)
+            initBalanceThresholds(argv[i+1]);
     }
     if(mainOutputPath.empty() || !fs::exists(mainOutputPath))
         mainOutputPath = basePath;
     if(mainAlgorithmsPath.empty() || !fs::exists(mainAlgorithmsPath))
         mainAlgorithmsPath = basePath;
+    if(mainNumThreads <= 0)
+        mainNumThreads = std::max((int)std::thread::hardware_concurrency(), 1);
 
     if(mainTravelPath.empty()) {
         NO_TRAVEL_PATH;
@@ -94,23 +199,51 @@ void getAlgSoFiles(vector<fs::path> &algPaths){
     }
 }
 
+/**
+ * This function creates the validation cache at mainCachePath, the algorithms are identified by their .so file
+ */
+std::unique_ptr<ValidationCache> initValidationCache(vector<fs::path> &algPaths){
+    std::map<string,fs::path> algBinaries;
+    for(auto &path : algPaths)
+        algBinaries.insert({path.stem().string(), path});
+    auto cache = std::make_unique<ValidationCache>(mainCachePath, algBinaries, std::max(mainCacheMaxEntries, 1),
+                                                   (uintmax_t)std::max(mainCacheMaxMb, 1) << 20);
+    if(mainClearCache)
+        cache->clear();
+    return cache;
+}
+
 int main(int argc, char** argv) {
     map<string ,std::function<std::unique_ptr<AbstractAlgorithm>()>> map;
     vector<fs::path> algPaths;
     initPaths(argc,argv);
-    SimulatorObj simulator(mainTravelPath,mainOutputPath);
+    SimulatorObj simulator(mainTravelPath,mainOutputPath,mainNumThreads,mainStreamWindow);
+    simulator.setErrorsCap((size_t)std::max(mainMaxErrorsPerCode, 0));
+    simulator.setSampledValidation(mainSampledValidation);
+    simulator.setPipelined(mainPipeline);
+    simulator.setBalanceThresholds(mainBalanceX, mainBalanceY);
+    if(mainValidateOnly){
+        simulator.validateExistingInstructions();
+        simulator.createResultsFile();
+        simulator.createErrorsFile();
+        return (EXIT_SUCCESS);
+    }
     getAlgSoFiles(algPaths);
     auto& registrar = AlgorithmFactoryRegistrar::getRegistrar();
     registrar.dynamicLoadSoFiles(algPaths, map);
+    if(!mainCachePath.empty())
+        simulator.setValidationCache(initValidationCache(algPaths));
 
     /*Cartesian Loop*/
-    for (auto &travel : simulator.getTravels()) {
+    simulator.forEachTravel([&simulator, &map](std::unique_ptr<Travel> &travel) {
         vector<pair<string,std::unique_ptr<AbstractAlgorithm>>> algVec = initAlgorithmList(map);
-        std::unique_ptr<Ship> mainShip = extractArgsForShip(travel, simulator);
-        if(mainShip != nullptr){
+        std::unique_ptr<Ship> &mainShip = travel->getShip();
+        if(!travel->isErroneous()){
+            simulator.updateErrorCodes(travel->getSimErrorCodes(), "sim");
             for (auto &alg : algVec) {
                 int errCode1 = 0, errCode2 = 0;
                 WeightBalanceCalculator algCalc;
+                algCalc.setImbalanceThresholds(mainBalanceX, mainBalanceY);
                 try {
                     errCode1 = alg.second->readShipPlan(travel->getPlanPath().string());
                     errCode2 = alg.second->readShipRoute(travel->getRoutePath().string());
@@ -126,10 +259,8 @@ int main(int argc, char** argv) {
                 simulator.runAlgorithm(alg, travel);
             }
         }
-        else
-            travel->setErroneousTravel();
         simulator.prepareNextIteration();
-    }
+    });
     simulator.createResultsFile();
     simulator.createErrorsFile();
     return (EXIT_SUCCESS);